@@ -267,7 +267,7 @@ def print_doc(*, full_name: str, parent: object, obj: object, level: int) -> Opt
             dataclass_prop += '(frozen=True)'
         out_obj.lines.append(dataclass_prop)
 
-    out_obj.lines.append(text.replace('._stim_avx2', '').replace('._stim_sse2', ''))
+    out_obj.lines.append(text.replace('._stim_avx512', '').replace('._stim_avx2', '').replace('._stim_sse2', ''))
     if has_setter:
         if '->' in sig_name:
             setter_type = sig_name[sig_name.index('->') + 2:].strip().replace('._stim_avx2', '')
@@ -3879,9 +3879,9 @@ class CompiledDetectorSampler:
         shots: int,
         *,
         filepath: Union[str, pathlib.Path],
-        format: 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]' = '01',
+        format: 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]' = '01',
         obs_out_filepath: Optional[Union[str, pathlib.Path]] = None,
-        obs_out_format: 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]' = '01',
+        obs_out_format: 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]' = '01',
         prepend_observables: bool = False,
         append_observables: bool = False,
     ) -> None:
@@ -3891,7 +3891,7 @@ class CompiledDetectorSampler:
             shots: The number of times to sample every measurement in the circuit.
             filepath: The file to write the results to.
             format: The output format to write the results with.
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
             obs_out_filepath: Sample observables as part of each shot, and write them to
                 this file. This keeps the observable data separate from the detector
@@ -3899,7 +3899,7 @@ class CompiledDetectorSampler:
             obs_out_format: If writing the observables to a file, this is the format to
                 write them in.
 
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
             prepend_observables: Sample observables as part of each shot, and put them
                 at the start of the detector data.
@@ -4112,7 +4112,7 @@ class CompiledMeasurementSampler:
             shots: The number of times to sample every measurement in the circuit.
             filepath: The file to write the results to.
             format: The output format to write the results with.
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
 
         Returns:
@@ -4292,11 +4292,11 @@ class CompiledMeasurementsToDetectionEventsConverter:
         Args:
             measurements_filepath: A file containing measurement data to be converted.
             measurements_format: The format the measurement data is stored in.
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
             detection_events_filepath: Where to save detection event data to.
             detection_events_format: The format to save the detection event data in.
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
             sweep_bits_filepath: Defaults to None. A file containing sweep data, or
                 None. When specified, sweep data (used for `sweep[k]` controls in the
@@ -4304,14 +4304,14 @@ class CompiledMeasurementsToDetectionEventsConverter:
                 file. When not specified, all sweep bits default to False and no
                 sweep-controlled operations occur.
             sweep_bits_format: The format the sweep data is stored in.
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
             obs_out_filepath: Sample observables as part of each shot, and write them to
                 this file. This keeps the observable data separate from the detector
                 data.
             obs_out_format: If writing the observables to a file, this is the format to
                 write them in.
-                Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                 Defaults to "01".
             append_observables: When True, the observables in the circuit are included
                 as part of the detection event data. Specifically, they are treated as
@@ -12021,7 +12021,7 @@ def main(
 def read_shot_data_file(
     *,
     path: Union[str, pathlib.Path],
-    format: Union[str, 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]'],
+    format: Union[str, 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]'],
     bit_packed: bool = False,
     num_measurements: int = 0,
     num_detectors: int = 0,
@@ -12032,7 +12032,7 @@ def read_shot_data_file(
 def read_shot_data_file(
     *,
     path: Union[str, pathlib.Path],
-    format: Union[str, 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]'],
+    format: Union[str, 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]'],
     bit_packed: bool = False,
     num_measurements: int = 0,
     num_detectors: int = 0,
@@ -12043,7 +12043,7 @@ def read_shot_data_file(
 def read_shot_data_file(
     *,
     path: Union[str, pathlib.Path],
-    format: Union[str, 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]'],
+    format: Union[str, 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]'],
     bit_packed: bool = False,
     num_measurements: int = 0,
     num_detectors: int = 0,
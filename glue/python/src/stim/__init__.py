@@ -10,11 +10,14 @@ import stim._detect_machine_architecture as _tmp
 
 _tmp = _tmp._UNSTABLE_detect_march()
 try:
+    if _tmp == 'avx512':
+        from stim._stim_avx512 import _UNSTABLE_raw_format_data, __version__
+        from stim._stim_avx512 import *
     # NOTE: avx2 disabled until https://github.com/quantumlib/Stim/issues/432 is fixed
-    # if _tmp == 'avx2':
+    # elif _tmp == 'avx2':
     #     from stim._stim_avx2 import _UNSTABLE_raw_format_data, __version__
     #     from stim._stim_avx2 import *
-    if _tmp == 'avx2' or _tmp == 'sse2':
+    elif _tmp == 'avx2' or _tmp == 'sse2':
         from stim._stim_sse2 import _UNSTABLE_raw_format_data, __version__
         from stim._stim_sse2 import *
     else:
@@ -33,6 +33,7 @@ if platform.system().startswith('Win'):
         '/O2',
         f'/DVERSION_INFO={__version__}',
     ]
+    arch_avx512 = ['/arch:AVX512']
     arch_avx = ['/arch:AVX2']
     arch_sse = ['/arch:SSE2']
     arch_basic = []
@@ -44,6 +45,7 @@ else:
         '-g0',
         f'-DVERSION_INFO={__version__}',
     ]
+    arch_avx512 = ['-mavx512f', '-mavx2']
     arch_avx = ['-mavx2']
     arch_sse = ['-msse2', '-mno-avx2']
     arch_basic = []
@@ -80,6 +82,17 @@ stim_sse2 = Extension(
         '-DSTIM_PYBIND11_MODULE_NAME=_stim_sse2',
     ],
 )
+stim_avx512 = Extension(
+    'stim._stim_avx512',
+    sources=RELEVANT_SOURCE_FILES,
+    include_dirs=[pybind11.get_include(), "src"],
+    language='c++',
+    extra_compile_args=[
+        *common_compile_args,
+        *arch_avx512,
+        '-DSTIM_PYBIND11_MODULE_NAME=_stim_avx512',
+    ],
+)
 
 # NOTE: disabled until https://github.com/quantumlib/Stim/issues/432 is fixed
 # stim_avx2 = Extension(
@@ -104,7 +117,8 @@ def _get_extensions():
         # stim_avx2,
         return [stim_detect_machine_architecture, stim_polyfill,
                 # stim_avx2,
-                stim_sse2]
+                stim_sse2,
+                stim_avx512]
     else:
         return [stim_detect_machine_architecture, stim_polyfill]
 
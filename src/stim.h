@@ -45,9 +45,11 @@
 #include "stim/gen/gen_color_code.h"
 #include "stim/gen/gen_rep_code.h"
 #include "stim/gen/gen_surface_code.h"
+#include "stim/io/background_writer.h"
 #include "stim/io/measure_record.h"
 #include "stim/io/measure_record_batch.h"
 #include "stim/io/measure_record_batch_writer.h"
+#include "stim/io/measure_record_index.h"
 #include "stim/io/measure_record_reader.h"
 #include "stim/io/measure_record_writer.h"
 #include "stim/io/raii_file.h"
@@ -58,6 +60,7 @@
 #include "stim/mem/bitword.h"
 #include "stim/mem/bitword_128_sse.h"
 #include "stim/mem/bitword_256_avx.h"
+#include "stim/mem/bitword_512_avx512.h"
 #include "stim/mem/bitword_64.h"
 #include "stim/mem/fixed_cap_vector.h"
 #include "stim/mem/monotonic_buffer.h"
@@ -102,6 +105,7 @@
 #include "stim/stabilizers/tableau_transposed_raii.h"
 #include "stim/util_bot/arg_parse.h"
 #include "stim/util_bot/error_decomp.h"
+#include "stim/util_bot/parallel_util.h"
 #include "stim/util_bot/probability_util.h"
 #include "stim/util_bot/str_util.h"
 #include "stim/util_bot/twiddle.h"
@@ -117,6 +121,7 @@
 #include "stim/util_top/export_qasm.h"
 #include "stim/util_top/export_quirk_url.h"
 #include "stim/util_top/has_flow.h"
+#include "stim/util_top/reference_sample_cache.h"
 #include "stim/util_top/reference_sample_tree.h"
 #include "stim/util_top/simplified_circuit.h"
 #include "stim/util_top/stabilizers_to_tableau.h"
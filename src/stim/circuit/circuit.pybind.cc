@@ -46,6 +46,7 @@
 #include "stim/util_top/export_qasm.h"
 #include "stim/util_top/export_quirk_url.h"
 #include "stim/util_top/has_flow.h"
+#include "stim/util_top/reference_sample_tree.h"
 #include "stim/util_top/simplified_circuit.h"
 #include "stim/util_top/transform_without_feedback.h"
 
@@ -731,7 +732,7 @@ void stim_pybind::pybind_circuit_methods(pybind11::module &, pybind11::class_<Ci
     c.def(
         "reference_sample",
         [](const Circuit &self, bool bit_packed) {
-            auto ref = TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(self);
+            auto ref = reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(self);
             simd_bits_range_ref<MAX_BITWORD_WIDTH> reference_sample(ref.ptr_simd, ref.num_simd_words);
             size_t num_measure = self.count_measurements();
             return simd_bits_to_numpy(reference_sample, num_measure, bit_packed);
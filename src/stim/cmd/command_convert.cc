@@ -19,6 +19,7 @@
 #include "command_help.h"
 #include "stim/dem/detector_error_model.h"
 #include "stim/io/measure_record_batch_writer.h"
+#include "stim/io/measure_record_index.h"
 #include "stim/io/measure_record_reader.h"
 #include "stim/io/stim_data_formats.h"
 #include "stim/mem/simd_bits.h"
@@ -124,6 +125,8 @@ int stim::command_convert(int argc, const char **argv) {
             "--num_detectors",
             "--num_observables",
             "--bits_per_shot",
+            "--out_index",
+            "--out_index_period",
         },
         {},
         "convert",
@@ -138,6 +141,11 @@ int stim::command_convert(int argc, const char **argv) {
     FILE *in = find_open_file_argument("--in", stdin, "rb", argc, argv);
     FILE *out = find_open_file_argument("--out", stdout, "wb", argc, argv);
     FILE *obs_out = find_open_file_argument("--obs_out", stdout, "wb", argc, argv);
+    FILE *index_out = find_open_file_argument("--out_index", stdout, "wb", argc, argv);
+    uint64_t index_period = (uint64_t)find_int64_argument("--out_index_period", 1024, 1, INT64_MAX, argc, argv);
+    if (index_out == stdout) {
+        index_out = nullptr;
+    }
 
     // Determine the necessary data needed to parse the input and
     // write to the new output.
@@ -195,8 +203,12 @@ int stim::command_convert(int argc, const char **argv) {
     }
 
     simd_bits<MAX_BITWORD_WIDTH> buf(reader->bits_per_record());
+    MeasureRecordIndex index(index_period);
 
     while (reader->start_and_read_entire_record(buf)) {
+        if (index_out != nullptr) {
+            index.add_shot(tell_file_position(out));
+        }
         int64_t offset = 0;
         if (details.include_measurements) {
             writer->begin_result_type('M');
@@ -241,6 +253,10 @@ int stim::command_convert(int argc, const char **argv) {
     if (obs_out != nullptr) {
         fclose(obs_out);
     }
+    if (index_out != nullptr) {
+        index.write_index_file(index_out);
+        fclose(index_out);
+    }
     return EXIT_SUCCESS;
 }
 
@@ -348,7 +364,7 @@ SubCommandHelp stim::command_convert_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--in_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -359,6 +375,7 @@ SubCommandHelp stim::command_convert_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -371,7 +388,7 @@ SubCommandHelp stim::command_convert_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -382,6 +399,7 @@ SubCommandHelp stim::command_convert_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -394,7 +412,7 @@ SubCommandHelp stim::command_convert_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--obs_out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -407,6 +425,7 @@ SubCommandHelp stim::command_convert_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -470,6 +489,37 @@ SubCommandHelp stim::command_convert_help() {
         )PARAGRAPH"),
     });
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            Specifies a file to write an index of the output data to.
+
+            The index lists the byte offsets of periodically spaced shots in
+            the output file (every `--out_index_period` shots). It can be given
+            to `stim m2d --in_index` so that a conversion starting in the middle
+            of the file (`--skip_shots`) can seek directly to its first shot,
+            allowing separate processes to work on separate parts of one file.
+
+            Writing an index requires `--out` to be a seekable file.
+        )PARAGRAPH"),
+    });
+
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index_period",
+        "int",
+        "1024",
+        {"[none]", "int"},
+        clean_doc_string(R"PARAGRAPH(
+            The number of shots between entries in the `--out_index` file.
+
+            Smaller values make seeking more precise, at the cost of a larger
+            index file.
+        )PARAGRAPH"),
+    });
+
     result.flags.push_back(SubCommandHelpFlag{
         "--circuit",
         "filepath",
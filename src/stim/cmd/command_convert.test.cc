@@ -32,7 +32,8 @@ TEST(command_convert, convert_measurements_with_circuit_to_dets) {
         std::make_tuple("01", "00\n01\n10\n11\n"),
         std::make_tuple("b8", std::string({0x00, 0x02, 0x01, 0x03})),
         std::make_tuple("hits", "\n1\n0\n0,1\n"),
-        std::make_tuple("r8", std::string({0x02, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00}))};
+        std::make_tuple("r8", std::string({0x02, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00})),
+        std::make_tuple("rice", std::string("\xC0\x00\x40\x00\x80\x00\x00\x00", 8))};
 
     for (const auto& [in_format, in_data] : measurement_data) {
         ASSERT_EQ(
@@ -81,7 +82,8 @@ TEST(command_convert, convert_detections_observables_with_circuit_to_dets) {
         std::make_tuple("hits", "\n0,1\n1,2\n2,3\n3\n3,4\n"),
         std::make_tuple(
             "r8",
-            std::string({0x05, 0x00, 0x00, 0x03, 0x01, 0x00, 0x02, 0x02, 0x00, 0x01, 0x03, 0x01, 0x03, 0x00, 0x00}))};
+            std::string({0x05, 0x00, 0x00, 0x03, 0x01, 0x00, 0x02, 0x02, 0x00, 0x01, 0x03, 0x01, 0x03, 0x00, 0x00})),
+        std::make_tuple("rice", std::string("\xC1\x02\x00\x07\x40\x06\xC0\x04\x41\x05\xC0\x01", 12))};
 
     for (const auto& [in_format, in_data] : detection_data) {
         ASSERT_EQ(
@@ -131,7 +133,8 @@ TEST(command_convert, convert_detections_observables_with_circuit_to_dets_with_o
         std::make_tuple("hits", "\n0,1\n1,2\n2,3\n3\n3,4\n"),
         std::make_tuple(
             "r8",
-            std::string({0x05, 0x00, 0x00, 0x03, 0x01, 0x00, 0x02, 0x02, 0x00, 0x01, 0x03, 0x01, 0x03, 0x00, 0x00}))};
+            std::string({0x05, 0x00, 0x00, 0x03, 0x01, 0x00, 0x02, 0x02, 0x00, 0x01, 0x03, 0x01, 0x03, 0x00, 0x00})),
+        std::make_tuple("rice", std::string("\xC1\x02\x00\x07\x40\x06\xC0\x04\x41\x05\xC0\x01", 12))};
 
     for (const auto& [in_format, in_data] : detection_data) {
         ASSERT_EQ(
@@ -177,7 +180,8 @@ TEST(command_convert, convert_detections_observables_with_circuit_no_dets) {
         std::make_tuple("01", "10100\n00011\n00000\n00100\n00000\n10000\n"),
         std::make_tuple("b8", std::string({0x05, 0x18, 0x00, 0x04, 0x00, 0x01})),
         std::make_tuple("hits", "0,2\n3,4\n\n2\n\n0\n"),
-        std::make_tuple("r8", std::string({0x00, 0x01, 0x02, 0x03, 0x00, 0x00, 0x05, 0x02, 0x02, 0x05, 0x00, 0x04}))};
+        std::make_tuple("r8", std::string({0x00, 0x01, 0x02, 0x03, 0x00, 0x00, 0x05, 0x02, 0x02, 0x05, 0x00, 0x04})),
+        std::make_tuple("rice", std::string("\x80\x06\xC0\x01\xC1\x02\xC0\x06\xC1\x02\x80\x07", 12))};
 
     for (const auto& [in_format, in_data] : detection_data) {
         for (const auto& [out_format, out_data] : detection_data) {
@@ -209,7 +213,8 @@ TEST(command_convert, convert_detections_observables_with_dem) {
         std::make_tuple("b8", std::string({0x01, 0x13, 0x00, 0x12})),
         std::make_tuple("dets", "shot D0\nshot D0 D1 L2\nshot\nshot D1 L2\n"),
         std::make_tuple("hits", "0\n0,1,4\n\n1,4\n"),
-        std::make_tuple("r8", std::string({0x00, 0x04, 0x00, 0x00, 0x02, 0x00, 0x05, 0x01, 0x02, 0x00}))};
+        std::make_tuple("r8", std::string({0x00, 0x04, 0x00, 0x00, 0x02, 0x00, 0x05, 0x01, 0x02, 0x00})),
+        std::make_tuple("rice", std::string("\x80\x07\x00\x03\xC1\x02\x40\x03", 8))};
 
     for (const auto& [in_format, in_data] : detection_data) {
         for (const auto& [out_format, out_data] : detection_data) {
@@ -236,7 +241,8 @@ TEST(command_convert, convert_measurements_no_circuit_or_dem) {
         std::make_tuple("dets", "shot M0\nshot M1\nshot M0 M1\nshot M2\nshot M1\nshot M0 M1 M2\n"),
         std::make_tuple(
             "r8",
-            std::string({0x00, 0x02, 0x01, 0x01, 0x00, 0x00, 0x01, 0x02, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00}))};
+            std::string({0x00, 0x02, 0x01, 0x01, 0x00, 0x00, 0x01, 0x02, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00})),
+        std::make_tuple("rice", std::string("\x80\x01\x40\x01\x00\x01\xC0\x00\x40\x01\x00\x00", 12))};
 
     for (const auto& [in_format, in_data] : measurement_data) {
         for (const auto& [out_format, out_data] : measurement_data) {
@@ -261,7 +267,8 @@ TEST(command_convert, convert_detections_observables_no_circuit_or_dem) {
         std::make_tuple("b8", std::string({0x01, 0x13, 0x00, 0x12})),
         std::make_tuple("dets", "shot D0\nshot D0 D1 L2\nshot\nshot D1 L2\n"),
         std::make_tuple("hits", "0\n0,1,4\n\n1,4\n"),
-        std::make_tuple("r8", std::string({0x00, 0x04, 0x00, 0x00, 0x02, 0x00, 0x05, 0x01, 0x02, 0x00}))};
+        std::make_tuple("r8", std::string({0x00, 0x04, 0x00, 0x00, 0x02, 0x00, 0x05, 0x01, 0x02, 0x00})),
+        std::make_tuple("rice", std::string("\x80\x07\x00\x03\xC1\x02\x40\x03", 8))};
 
     for (const auto& [in_format, in_data] : detection_data) {
         for (const auto& [out_format, out_data] : detection_data) {
@@ -287,7 +294,8 @@ TEST(command_convert, convert_bits_per_shot_no_dets) {
         std::make_tuple("01", "00\n01\n10\n11\n"),
         std::make_tuple("b8", std::string({0x00, 0x02, 0x01, 0x03})),
         std::make_tuple("hits", "\n1\n0\n0,1\n"),
-        std::make_tuple("r8", std::string({0x02, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00}))};
+        std::make_tuple("r8", std::string({0x02, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00})),
+        std::make_tuple("rice", std::string("\xC0\x00\x40\x00\x80\x00\x00\x00", 8))};
 
     for (const auto& [in_format, in_data] : measurement_data) {
         for (const auto& [out_format, out_data] : measurement_data) {
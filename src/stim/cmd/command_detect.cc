@@ -15,6 +15,7 @@
 #include "stim/cmd/command_detect.h"
 
 #include "command_help.h"
+#include "stim/io/measure_record_index.h"
 #include "stim/io/raii_file.h"
 #include "stim/io/stim_data_formats.h"
 #include "stim/simulators/frame_simulator_util.h"
@@ -25,7 +26,16 @@ using namespace stim;
 
 int stim::command_detect(int argc, const char **argv) {
     check_for_unknown_arguments(
-        {"--seed", "--shots", "--append_observables", "--out_format", "--out", "--in", "--obs_out", "--obs_out_format"},
+        {"--seed",
+         "--shots",
+         "--append_observables",
+         "--out_format",
+         "--out",
+         "--in",
+         "--obs_out",
+         "--obs_out_format",
+         "--out_index",
+         "--out_index_period"},
         {"--detect", "--prepend_observables"},
         "detect",
         argc,
@@ -46,8 +56,17 @@ int stim::command_detect(int argc, const char **argv) {
         prepend_observables = true;
     }
 
+    RaiiFile index_out(find_open_file_argument("--out_index", stdout, "wb", argc, argv));
+    uint64_t index_period = (uint64_t)find_int64_argument("--out_index_period", 1024, 1, INT64_MAX, argc, argv);
+    if (index_out.f == stdout) {
+        index_out.f = nullptr;
+    } else if (find_argument("--out", argc, argv) == nullptr) {
+        throw std::invalid_argument("Writing an --out_index requires specifying --out.");
+    }
+
     RaiiFile in(find_open_file_argument("--in", stdin, "rb", argc, argv));
-    RaiiFile out(find_open_file_argument("--out", stdout, "wb", argc, argv));
+    // The output is read back after being written, when it needs to be indexed.
+    RaiiFile out(find_open_file_argument("--out", stdout, index_out.f == nullptr ? "wb" : "wb+", argc, argv));
     RaiiFile obs_out(find_open_file_argument("--obs_out", stdout, "wb", argc, argv));
     if (obs_out.f == stdout) {
         obs_out.f = nullptr;
@@ -59,6 +78,9 @@ int stim::command_detect(int argc, const char **argv) {
         out.responsible_for_closing = false;
     }
     if (num_shots == 0) {
+        if (index_out.f != nullptr) {
+            MeasureRecordIndex(index_period).write_index_file(index_out.f);
+        }
         return EXIT_SUCCESS;
     }
 
@@ -75,6 +97,15 @@ int stim::command_detect(int argc, const char **argv) {
         rng,
         obs_out.f,
         obs_out_format.id);
+
+    if (index_out.f != nullptr) {
+        auto stats = circuit.compute_stats();
+        size_t num_observables_in_out = prepend_observables || append_observables ? stats.num_observables : 0;
+        seek_file_position(out.f, 0);
+        MeasureRecordIndex::from_data_file(
+            out.f, out_format.id, 0, stats.num_detectors, num_observables_in_out, index_period)
+            .write_index_file(index_out.f);
+    }
     return EXIT_SUCCESS;
 }
 
@@ -131,7 +162,7 @@ SubCommandHelp stim::command_detect_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -142,6 +173,7 @@ SubCommandHelp stim::command_detect_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -259,7 +291,7 @@ SubCommandHelp stim::command_detect_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--obs_out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -272,6 +304,7 @@ SubCommandHelp stim::command_detect_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -314,5 +347,36 @@ SubCommandHelp stim::command_detect_help() {
         )PARAGRAPH"),
     });
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            Specifies a file to write an index of the output data to.
+
+            The index lists the byte offsets of periodically spaced shots in
+            the `--out` file (every `--out_index_period` shots). It can be given
+            to `stim m2d --in_index` so that a conversion starting in the middle
+            of the file (`--skip_shots`) can seek directly to its first shot,
+            allowing separate processes to work on separate parts of one file.
+
+            Writing an index requires `--out` to be specified.
+        )PARAGRAPH"),
+    });
+
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index_period",
+        "int",
+        "1024",
+        {"[none]", "int"},
+        clean_doc_string(R"PARAGRAPH(
+            The number of shots between entries in the `--out_index` file.
+
+            Smaller values make seeking more precise, at the cost of a larger
+            index file.
+        )PARAGRAPH"),
+    });
+
     return result;
 }
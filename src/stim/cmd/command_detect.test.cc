@@ -15,6 +15,7 @@
 #include "gtest/gtest.h"
 
 #include "stim/main_namespaced.test.h"
+#include "stim/util_bot/test_util.test.h"
 
 using namespace stim;
 
@@ -232,3 +233,36 @@ TEST(command_detect, seeded_detecting) {
                 DETECTOR rec[-1]
             )input"));
 }
+
+TEST(command_detect, out_index) {
+    RaiiTempNamedFile circuit(R"CIRCUIT(
+        X_ERROR(1) 1
+        M 0 1
+        DETECTOR rec[-2]
+        DETECTOR rec[-1]
+        OBSERVABLE_INCLUDE(0) rec[-1]
+    )CIRCUIT");
+    RaiiTempNamedFile out;
+    RaiiTempNamedFile index;
+
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "detect",
+            "--shots=5",
+            "--in",
+            circuit.path.c_str(),
+            "--out",
+            out.path.c_str(),
+            "--out_format=dets",
+            "--append_observables",
+            "--out_index",
+            index.path.c_str(),
+            "--out_index_period=2",
+        }),
+        "");
+    ASSERT_EQ(out.read_contents(), "shot D1 L0\nshot D1 L0\nshot D1 L0\nshot D1 L0\nshot D1 L0\n");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 2\nnum_shots 5\n0\n22\n44\n");
+
+    auto err = run_captured_stim_main({"detect", "--shots=5", "--out_index", index.path.c_str()}, "M 0\n");
+    ASSERT_NE(err.find("requires specifying --out"), std::string::npos) << err;
+}
@@ -18,6 +18,7 @@
 #include "stim/io/stim_data_formats.h"
 #include "stim/simulators/measurements_to_detection_events.h"
 #include "stim/util_bot/arg_parse.h"
+#include "stim/util_top/reference_sample_cache.h"
 #include "stim/util_top/transform_without_feedback.h"
 
 using namespace stim;
@@ -32,11 +33,15 @@ int stim::command_m2d(int argc, const char **argv) {
             "--out",
             "--in",
             "--skip_reference_sample",
+            "--reference_sample_cache",
             "--sweep",
             "--sweep_format",
             "--obs_out",
             "--obs_out_format",
             "--ran_without_feedback",
+            "--in_index",
+            "--skip_shots",
+            "--max_shots",
         },
         {
             "--m2d",
@@ -50,7 +55,19 @@ int stim::command_m2d(int argc, const char **argv) {
     const auto &obs_out_format = find_enum_argument("--obs_out_format", "01", format_name_to_enum_map(), argc, argv);
     bool append_observables = find_bool_argument("--append_observables", argc, argv);
     bool skip_reference_sample = find_bool_argument("--skip_reference_sample", argc, argv);
+    std::string reference_sample_cache =
+        choose_reference_sample_cache_dir(find_argument("--reference_sample_cache", argc, argv));
     bool ran_without_feedback = find_bool_argument("--ran_without_feedback", argc, argv);
+    uint64_t skip_shots = (uint64_t)find_int64_argument("--skip_shots", 0, 0, INT64_MAX, argc, argv);
+    uint64_t max_shots = find_argument("--max_shots", argc, argv) == nullptr
+                             ? UINT64_MAX
+                             : (uint64_t)find_int64_argument("--max_shots", 0, 0, INT64_MAX, argc, argv);
+    std::unique_ptr<MeasureRecordIndex> in_index;
+    FILE *in_index_file = find_open_file_argument("--in_index", stdin, "rb", argc, argv);
+    if (in_index_file != stdin) {
+        in_index = std::make_unique<MeasureRecordIndex>(MeasureRecordIndex::from_index_file(in_index_file));
+        fclose(in_index_file);
+    }
     FILE *circuit_file = find_open_file_argument("--circuit", nullptr, "rb", argc, argv);
     auto circuit = Circuit::from_file(circuit_file);
     fclose(circuit_file);
@@ -69,18 +86,30 @@ int stim::command_m2d(int argc, const char **argv) {
         obs_out = nullptr;
     }
 
-    stream_measurements_to_detection_events<MAX_BITWORD_WIDTH>(
+    CircuitStats circuit_stats = circuit.compute_stats();
+    simd_bits<MAX_BITWORD_WIDTH> reference_sample(circuit_stats.num_measurements);
+    if (!skip_reference_sample) {
+        reference_sample =
+            reference_sample_cache.empty()
+                ? reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit)
+                : reference_sample_circuit_with_cache<MAX_BITWORD_WIDTH>(circuit, reference_sample_cache);
+    }
+    stream_measurements_to_detection_events_helper<MAX_BITWORD_WIDTH>(
         in,
         in_format.id,
         sweep_in,
         sweep_format.id,
         out,
         out_format.id,
-        circuit,
+        circuit.aliased_noiseless_circuit(),
+        circuit_stats,
         append_observables,
-        skip_reference_sample,
+        reference_sample,
         obs_out,
-        obs_out_format.id);
+        obs_out_format.id,
+        skip_shots,
+        max_shots,
+        in_index.get());
     if (in != stdin) {
         fclose(in);
     }
@@ -144,7 +173,7 @@ SubCommandHelp stim::command_m2d_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -155,6 +184,7 @@ SubCommandHelp stim::command_m2d_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -188,7 +218,7 @@ SubCommandHelp stim::command_m2d_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--obs_out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -201,6 +231,7 @@ SubCommandHelp stim::command_m2d_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -213,7 +244,7 @@ SubCommandHelp stim::command_m2d_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--in_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -224,6 +255,7 @@ SubCommandHelp stim::command_m2d_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -259,7 +291,7 @@ SubCommandHelp stim::command_m2d_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--sweep_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -270,6 +302,7 @@ SubCommandHelp stim::command_m2d_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -296,6 +329,56 @@ SubCommandHelp stim::command_m2d_help() {
         )PARAGRAPH"),
     });
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--in_index",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            Specifies an index of the measurement data file given by `--in`.
+
+            The index lists the byte offsets of periodically spaced shots in
+            the measurement data, allowing `--skip_shots` to seek near the
+            first converted shot instead of reading and discarding all of the
+            skipped shots. Indices can be created using `stim convert` with the
+            `--out_index` flag.
+
+            The index is not needed for the b8 and ptb64 formats, because their
+            shots have a fixed size.
+        )PARAGRAPH"),
+    });
+
+    result.flags.push_back(SubCommandHelpFlag{
+        "--skip_shots",
+        "int",
+        "0",
+        {"[none]", "int"},
+        clean_doc_string(R"PARAGRAPH(
+            Skips over this many shots at the start of the input data.
+
+            The same number of shots is also skipped in the sweep data, if
+            specified. Combined with `--max_shots`, this allows several m2d
+            processes to each convert a separate part of one large file.
+
+            Skipping shots requires the input to be seekable, unless there are
+            no shots to skip. For the ptb64 format, the number of skipped shots
+            must be a multiple of 64.
+        )PARAGRAPH"),
+    });
+
+    result.flags.push_back(SubCommandHelpFlag{
+        "--max_shots",
+        "int",
+        "{all}",
+        {"[none]", "int"},
+        clean_doc_string(R"PARAGRAPH(
+            Stops after converting this many shots.
+
+            By default, all shots (after any skipped by `--skip_shots`) are
+            converted.
+        )PARAGRAPH"),
+    });
+
     result.flags.push_back(SubCommandHelpFlag{
         "--out",
         "filepath",
@@ -373,6 +456,28 @@ SubCommandHelp stim::command_m2d_help() {
         )PARAGRAPH"),
     });
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--reference_sample_cache",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            A directory used to cache reference samples between invocations.
+
+            When specified, the reference sample for the circuit is loaded
+            from this directory if it was stored there by a previous
+            invocation, instead of being recomputed. Otherwise it's computed
+            and then stored there. Entries are keyed by a hash of the circuit
+            with its noise removed, so circuits that differ only in noise
+            strength share an entry. The directory must already exist.
+
+            When not specified, the STIM_REFERENCE_SAMPLE_CACHE environment
+            variable is used as the cache directory, if it's set.
+
+            Has no effect when `--skip_reference_sample` is specified.
+        )PARAGRAPH"),
+    });
+
     result.flags.push_back(SubCommandHelpFlag{
         "--skip_reference_sample",
         "bool",
@@ -154,3 +154,75 @@ TEST(command_m2d, m2d_obs_size_misalign_11_obs) {
         trim(std::string(1024, '0') + "\n"));
     ASSERT_EQ(tmp_obs.read_contents(), "00000000000\n");
 }
+
+TEST(command_m2d, m2d_shot_range_with_index) {
+    RaiiTempNamedFile circuit(R"CIRCUIT(
+        M 0 1
+        DETECTOR rec[-2]
+        DETECTOR rec[-1]
+    )CIRCUIT");
+    RaiiTempNamedFile measurements("00\n01\n10\n11\n00\n01\n10\n11\n01\n");
+    RaiiTempNamedFile r8_measurements;
+    RaiiTempNamedFile index;
+
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "convert",
+            "--in_format=01",
+            "--out_format=r8",
+            "--bits_per_shot=2",
+            "--in",
+            measurements.path.c_str(),
+            "--out",
+            r8_measurements.path.c_str(),
+            "--out_index",
+            index.path.c_str(),
+            "--out_index_period=3",
+        }),
+        "");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 3\nnum_shots 9\n0\n5\n11\n");
+
+    for (const char *in_index : {"", index.path.c_str()}) {
+        std::vector<const char *> flags{
+            "m2d",
+            "--in_format=r8",
+            "--out_format=dets",
+            "--circuit",
+            circuit.path.c_str(),
+            "--in",
+            r8_measurements.path.c_str(),
+            "--skip_shots=3",
+            "--max_shots=4",
+        };
+        if (*in_index) {
+            flags.push_back("--in_index");
+            flags.push_back(in_index);
+        }
+        ASSERT_EQ(
+            trim(run_captured_stim_main(flags)),
+            trim(R"output(
+shot D0 D1
+shot
+shot D1
+shot D0
+            )output"));
+    }
+
+    ASSERT_EQ(
+        trim(run_captured_stim_main({
+            "m2d",
+            "--in_format=r8",
+            "--out_format=dets",
+            "--circuit",
+            circuit.path.c_str(),
+            "--in",
+            r8_measurements.path.c_str(),
+            "--in_index",
+            index.path.c_str(),
+            "--skip_shots=7",
+        })),
+        trim(R"output(
+shot D0 D1
+shot D1
+            )output"));
+}
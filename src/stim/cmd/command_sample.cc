@@ -15,33 +15,57 @@
 #include "stim/cmd/command_sample.h"
 
 #include "command_help.h"
+#include "stim/io/measure_record_index.h"
 #include "stim/io/stim_data_formats.h"
 #include "stim/simulators/frame_simulator.h"
 #include "stim/simulators/frame_simulator_util.h"
 #include "stim/simulators/tableau_simulator.h"
 #include "stim/util_bot/arg_parse.h"
 #include "stim/util_bot/probability_util.h"
+#include "stim/util_top/reference_sample_cache.h"
 
 using namespace stim;
 
 int stim::command_sample(int argc, const char **argv) {
     check_for_unknown_arguments(
-        {"--seed", "--skip_reference_sample", "--out_format", "--out", "--in", "--shots"},
+        {"--seed",
+         "--skip_reference_sample",
+         "--reference_sample_cache",
+         "--out_format",
+         "--out",
+         "--in",
+         "--shots",
+         "--out_index",
+         "--out_index_period"},
         {"--sample", "--frame0"},
         "sample",
         argc,
         argv);
     const auto &out_format = find_enum_argument("--out_format", "01", format_name_to_enum_map(), argc, argv);
     bool skip_reference_sample = find_bool_argument("--skip_reference_sample", argc, argv);
+    std::string reference_sample_cache =
+        choose_reference_sample_cache_dir(find_argument("--reference_sample_cache", argc, argv));
     uint64_t num_shots =
         find_argument("--shots", argc, argv)    ? (uint64_t)find_int64_argument("--shots", 1, 0, INT64_MAX, argc, argv)
         : find_argument("--sample", argc, argv) ? (uint64_t)find_int64_argument("--sample", 1, 0, INT64_MAX, argc, argv)
                                                 : 1;
+    FILE *index_out = find_open_file_argument("--out_index", stdout, "wb", argc, argv);
+    uint64_t index_period = (uint64_t)find_int64_argument("--out_index_period", 1024, 1, INT64_MAX, argc, argv);
+    if (index_out == stdout) {
+        index_out = nullptr;
+    } else if (find_argument("--out", argc, argv) == nullptr) {
+        throw std::invalid_argument("Writing an --out_index requires specifying --out.");
+    }
     if (num_shots == 0) {
+        if (index_out != nullptr) {
+            MeasureRecordIndex(index_period).write_index_file(index_out);
+            fclose(index_out);
+        }
         return EXIT_SUCCESS;
     }
     FILE *in = find_open_file_argument("--in", stdin, "rb", argc, argv);
-    FILE *out = find_open_file_argument("--out", stdout, "wb", argc, argv);
+    // The output is read back after being written, when it needs to be indexed.
+    FILE *out = find_open_file_argument("--out", stdout, index_out == nullptr ? "wb" : "wb+", argc, argv);
     auto rng = optionally_seeded_rng(argc, argv);
     bool deprecated_frame0 = find_bool_argument("--frame0", argc, argv);
     if (deprecated_frame0) {
@@ -51,14 +75,30 @@ int stim::command_sample(int argc, const char **argv) {
 
     if (num_shots == 1 && !skip_reference_sample) {
         TableauSimulator<MAX_BITWORD_WIDTH>::sample_stream(in, out, out_format.id, false, rng);
+        if (index_out != nullptr) {
+            // The circuit was streamed instead of parsed, but the index of a single shot is known anyway.
+            MeasureRecordIndex index(index_period);
+            index.add_shot(0);
+            index.write_index_file(index_out);
+        }
     } else {
         assert(num_shots > 0);
         auto circuit = Circuit::from_file(in);
         simd_bits<MAX_BITWORD_WIDTH> ref(0);
         if (!skip_reference_sample) {
-            ref = TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(circuit);
+            ref = reference_sample_cache.empty()
+                      ? reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit)
+                      : reference_sample_circuit_with_cache<MAX_BITWORD_WIDTH>(circuit, reference_sample_cache);
         }
         sample_batch_measurements_writing_results_to_disk(circuit, ref, num_shots, out, out_format.id, rng);
+        if (index_out != nullptr) {
+            seek_file_position(out, 0);
+            MeasureRecordIndex::from_data_file(out, out_format.id, circuit.count_measurements(), 0, 0, index_period)
+                .write_index_file(index_out);
+        }
+    }
+    if (index_out != nullptr) {
+        fclose(index_out);
     }
 
     if (in != stdin) {
@@ -98,6 +138,28 @@ SubCommandHelp stim::command_sample_help() {
             shot M2 M3 M5
         )PARAGRAPH"));
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--reference_sample_cache",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            A directory used to cache reference samples between invocations.
+
+            When specified, the reference sample for the circuit is loaded
+            from this directory if it was stored there by a previous
+            invocation, instead of being recomputed. Otherwise it's computed
+            and then stored there. Entries are keyed by a hash of the circuit
+            with its noise removed, so circuits that differ only in noise
+            strength share an entry. The directory must already exist.
+
+            When not specified, the STIM_REFERENCE_SAMPLE_CACHE environment
+            variable is used as the cache directory, if it's set.
+
+            Has no effect when `--skip_reference_sample` is specified.
+        )PARAGRAPH"),
+    });
+
     result.flags.push_back(SubCommandHelpFlag{
         "--skip_reference_sample",
         "bool",
@@ -129,7 +191,7 @@ SubCommandHelp stim::command_sample_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -140,6 +202,7 @@ SubCommandHelp stim::command_sample_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -237,5 +300,36 @@ SubCommandHelp stim::command_sample_help() {
         )PARAGRAPH"),
     });
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            Specifies a file to write an index of the output data to.
+
+            The index lists the byte offsets of periodically spaced shots in
+            the `--out` file (every `--out_index_period` shots). It can be given
+            to `stim m2d --in_index` so that a conversion starting in the middle
+            of the file (`--skip_shots`) can seek directly to its first shot,
+            allowing separate processes to work on separate parts of one file.
+
+            Writing an index requires `--out` to be specified.
+        )PARAGRAPH"),
+    });
+
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index_period",
+        "int",
+        "1024",
+        {"[none]", "int"},
+        clean_doc_string(R"PARAGRAPH(
+            The number of shots between entries in the `--out_index` file.
+
+            Smaller values make seeking more precise, at the cost of a larger
+            index file.
+        )PARAGRAPH"),
+    });
+
     return result;
 }
@@ -18,6 +18,7 @@
 
 #include "stim/main_namespaced.test.h"
 #include "stim/util_bot/test_util.test.h"
+#include "stim/util_top/reference_sample_cache.h"
 
 using namespace stim;
 
@@ -416,3 +417,86 @@ TEST(command_sample, seeded_sampling) {
                 M 0
             )input"));
 }
+
+TEST(command_sample, out_index) {
+    RaiiTempNamedFile circuit("X 1\nM 0 1\n");
+    RaiiTempNamedFile out;
+    RaiiTempNamedFile index;
+
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "sample",
+            "--shots=5",
+            "--in",
+            circuit.path.c_str(),
+            "--out",
+            out.path.c_str(),
+            "--out_index",
+            index.path.c_str(),
+            "--out_index_period=2",
+        }),
+        "");
+    ASSERT_EQ(out.read_contents(), "01\n01\n01\n01\n01\n");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 2\nnum_shots 5\n0\n6\n12\n");
+
+    // Single shots are streamed without parsing the whole circuit.
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "sample",
+            "--shots=1",
+            "--in",
+            circuit.path.c_str(),
+            "--out",
+            out.path.c_str(),
+            "--out_index",
+            index.path.c_str(),
+        }),
+        "");
+    ASSERT_EQ(out.read_contents(), "01\n");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 1024\nnum_shots 1\n0\n");
+
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "sample",
+            "--shots=0",
+            "--in",
+            circuit.path.c_str(),
+            "--out",
+            out.path.c_str(),
+            "--out_index",
+            index.path.c_str(),
+        }),
+        "");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 1024\nnum_shots 0\n");
+
+    auto err = run_captured_stim_main({"sample", "--shots=5", "--out_index", index.path.c_str()}, "M 0\n");
+    ASSERT_NE(err.find("requires specifying --out"), std::string::npos) << err;
+}
+
+TEST(command_sample, reference_sample_cache) {
+    RaiiTempNamedFile circuit_file("X 0\nCX 0 1\nX_ERROR(0) 1\nM 0 1\n");
+    Circuit circuit("X 0\nCX 0 1\nM 0 1\n");
+    std::string cache_path = "/tmp/" + reference_sample_cache_file_name(circuit);
+
+    // Computes and stores the reference sample when it isn't cached.
+    remove(cache_path.c_str());
+    ASSERT_EQ(
+        run_captured_stim_main(
+            {"sample", "--shots=2", "--skip_reference_sample", "--reference_sample_cache=/tmp", "--in",
+             circuit_file.path.c_str()}),
+        "00\n00\n");
+    ASSERT_EQ(read_cached_reference_sample(cache_path, 2), std::nullopt);
+    ASSERT_EQ(
+        run_captured_stim_main(
+            {"sample", "--shots=2", "--reference_sample_cache=/tmp", "--in", circuit_file.path.c_str()}),
+        "11\n11\n");
+    ASSERT_EQ(read_cached_reference_sample(cache_path, 2)->str(), "1*('11')");
+
+    // Uses the cached reference sample when there is one.
+    write_cached_reference_sample(cache_path, ReferenceSampleTree::from_str("1*('01')"));
+    ASSERT_EQ(
+        run_captured_stim_main(
+            {"sample", "--shots=2", "--reference_sample_cache=/tmp", "--in", circuit_file.path.c_str()}),
+        "01\n01\n");
+    remove(cache_path.c_str());
+}
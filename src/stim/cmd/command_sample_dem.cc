@@ -15,6 +15,7 @@
 #include "stim/cmd/command_sample_dem.h"
 
 #include "command_help.h"
+#include "stim/io/measure_record_index.h"
 #include "stim/io/raii_file.h"
 #include "stim/simulators/dem_sampler.h"
 #include "stim/util_bot/arg_parse.h"
@@ -36,6 +37,8 @@ int stim::command_sample_dem(int argc, const char **argv) {
             "--err_out_format",
             "--replay_err_in",
             "--replay_err_in_format",
+            "--out_index",
+            "--out_index_period",
         },
         {},
         "sample_dem",
@@ -48,8 +51,17 @@ int stim::command_sample_dem(int argc, const char **argv) {
         find_enum_argument("--replay_err_in_format", "01", format_name_to_enum_map(), argc, argv);
     uint64_t num_shots = find_int64_argument("--shots", 1, 0, INT64_MAX, argc, argv);
 
+    RaiiFile index_out(find_open_file_argument("--out_index", stdout, "wb", argc, argv));
+    uint64_t index_period = (uint64_t)find_int64_argument("--out_index_period", 1024, 1, INT64_MAX, argc, argv);
+    if (index_out.f == stdout) {
+        index_out.f = nullptr;
+    } else if (find_argument("--out", argc, argv) == nullptr) {
+        throw std::invalid_argument("Writing an --out_index requires specifying --out.");
+    }
+
     RaiiFile in(find_open_file_argument("--in", stdin, "rb", argc, argv));
-    RaiiFile out(find_open_file_argument("--out", stdout, "wb", argc, argv));
+    // The output is read back after being written, when it needs to be indexed.
+    RaiiFile out(find_open_file_argument("--out", stdout, index_out.f == nullptr ? "wb" : "wb+", argc, argv));
     RaiiFile obs_out(find_open_file_argument("--obs_out", stdout, "wb", argc, argv));
     RaiiFile err_out(find_open_file_argument("--err_out", stdout, "wb", argc, argv));
     RaiiFile err_in(find_open_file_argument("--replay_err_in", stdin, "rb", argc, argv));
@@ -69,6 +81,9 @@ int stim::command_sample_dem(int argc, const char **argv) {
         out.responsible_for_closing = false;
     }
     if (num_shots == 0) {
+        if (index_out.f != nullptr) {
+            MeasureRecordIndex(index_period).write_index_file(index_out.f);
+        }
         return EXIT_SUCCESS;
     }
 
@@ -87,6 +102,11 @@ int stim::command_sample_dem(int argc, const char **argv) {
         err_in.f,
         err_in_format.id);
 
+    if (index_out.f != nullptr) {
+        seek_file_position(out.f, 0);
+        MeasureRecordIndex::from_data_file(out.f, out_format.id, 0, sampler.num_detectors, 0, index_period)
+            .write_index_file(index_out.f);
+    }
     return EXIT_SUCCESS;
 }
 
@@ -148,7 +168,7 @@ SubCommandHelp stim::command_sample_dem_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--replay_err_in_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -161,6 +181,7 @@ SubCommandHelp stim::command_sample_dem_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -189,7 +210,7 @@ SubCommandHelp stim::command_sample_dem_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--err_out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -202,6 +223,7 @@ SubCommandHelp stim::command_sample_dem_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -235,7 +257,7 @@ SubCommandHelp stim::command_sample_dem_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--obs_out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -248,6 +270,7 @@ SubCommandHelp stim::command_sample_dem_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -260,7 +283,7 @@ SubCommandHelp stim::command_sample_dem_help() {
 
     result.flags.push_back(SubCommandHelpFlag{
         "--out_format",
-        "01|b8|r8|ptb64|hits|dets",
+        "01|b8|r8|rice|ptb64|hits|dets",
         "01",
         {"[none]", "format"},
         clean_doc_string(R"PARAGRAPH(
@@ -271,6 +294,7 @@ SubCommandHelp stim::command_sample_dem_help() {
                 01 (default): dense human readable
                 b8: bit packed binary
                 r8: run length binary
+                rice: golomb-rice coded binary
                 ptb64: partially transposed bit packed binary for SIMD
                 hits: sparse human readable
                 dets: sparse human readable with type hints
@@ -369,5 +393,36 @@ SubCommandHelp stim::command_sample_dem_help() {
         )PARAGRAPH"),
     });
 
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index",
+        "filepath",
+        "",
+        {"[none]", "filepath"},
+        clean_doc_string(R"PARAGRAPH(
+            Specifies a file to write an index of the output data to.
+
+            The index lists the byte offsets of periodically spaced shots in
+            the `--out` file (every `--out_index_period` shots). It can be given
+            to `stim m2d --in_index` so that a conversion starting in the middle
+            of the file (`--skip_shots`) can seek directly to its first shot,
+            allowing separate processes to work on separate parts of one file.
+
+            Writing an index requires `--out` to be specified.
+        )PARAGRAPH"),
+    });
+
+    result.flags.push_back(SubCommandHelpFlag{
+        "--out_index_period",
+        "int",
+        "1024",
+        {"[none]", "int"},
+        clean_doc_string(R"PARAGRAPH(
+            The number of shots between entries in the `--out_index` file.
+
+            Smaller values make seeking more precise, at the cost of a larger
+            index file.
+        )PARAGRAPH"),
+    });
+
     return result;
 }
@@ -52,3 +52,49 @@ TEST(main, sample_dem) {
             )output"));
     ASSERT_EQ(obs_out.read_contents(), "001\n001\n001\n001\n001\n");
 }
+
+TEST(command_sample_dem, out_index) {
+    RaiiTempNamedFile dem(R"DEM(
+        error(1) D1
+        error(0) D0
+        detector D2
+    )DEM");
+    RaiiTempNamedFile out;
+    RaiiTempNamedFile index;
+
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "sample_dem",
+            "--shots=3",
+            "--in",
+            dem.path.c_str(),
+            "--out",
+            out.path.c_str(),
+            "--out_index",
+            index.path.c_str(),
+            "--out_index_period=1",
+        }),
+        "");
+    ASSERT_EQ(out.read_contents(), "010\n010\n010\n");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 1\nnum_shots 3\n0\n4\n8\n");
+
+    ASSERT_EQ(
+        run_captured_stim_main({
+            "sample_dem",
+            "--shots=3",
+            "--out_format=dets",
+            "--in",
+            dem.path.c_str(),
+            "--out",
+            out.path.c_str(),
+            "--out_index",
+            index.path.c_str(),
+            "--out_index_period=2",
+        }),
+        "");
+    ASSERT_EQ(out.read_contents(), "shot D1\nshot D1\nshot D1\n");
+    ASSERT_EQ(index.read_contents(), "shots_per_entry 2\nnum_shots 3\n0\n16\n");
+
+    auto err = run_captured_stim_main({"sample_dem", "--shots=5", "--out_index", index.path.c_str()}, "");
+    ASSERT_NE(err.find("requires specifying --out"), std::string::npos) << err;
+}
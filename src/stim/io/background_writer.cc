@@ -0,0 +1,44 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stim/io/background_writer.h"
+
+#include <system_error>
+
+using namespace stim;
+
+BackgroundWriter::~BackgroundWriter() {
+    if (pending.valid()) {
+        pending.wait();
+    }
+}
+
+void BackgroundWriter::start(std::function<void()> task) {
+    wait();
+    try {
+        pending = std::async(std::launch::async, task);
+    } catch (const std::system_error &) {
+        // Threads aren't available (e.g. a single threaded webassembly build). Do the work immediately instead.
+        task();
+    }
+}
+
+void BackgroundWriter::wait() {
+    if (pending.valid()) {
+        // Calling 'get' invalidates the future, so a rethrown exception is only reported once.
+        pending.get();
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _STIM_IO_BACKGROUND_WRITER_H
+#define _STIM_IO_BACKGROUND_WRITER_H
+
+#include <functional>
+#include <future>
+
+namespace stim {
+
+/// Runs output tasks on a background thread, so that computing the next batch of results can overlap with formatting
+/// and writing the previous batch.
+///
+/// At most one task runs at a time. Starting a task first waits for the previous task to finish, so tasks complete in
+/// the order they were started. This is meant to be used with a pair of swapped buffers:
+///
+///     compute batch into buffer A
+///     writer.wait()  // The task using buffer B is done.
+///     swap(A, B)
+///     writer.start(write buffer B)
+///
+/// Exceptions thrown by a task are rethrown by the next call to `wait` or `start`.
+struct BackgroundWriter {
+    std::future<void> pending;
+
+    BackgroundWriter() = default;
+    BackgroundWriter(const BackgroundWriter &other) = delete;
+    BackgroundWriter &operator=(const BackgroundWriter &other) = delete;
+    /// Waits for any unfinished task. Exceptions from the task are discarded; call `wait` to observe them.
+    ~BackgroundWriter();
+
+    /// Waits for the previous task (if any) to finish, then starts running the given task in the background.
+    void start(std::function<void()> task);
+    /// Blocks until the most recently started task has finished, rethrowing any exception it raised.
+    void wait();
+};
+
+}  // namespace stim
+
+#endif
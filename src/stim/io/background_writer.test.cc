@@ -0,0 +1,56 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stim/io/background_writer.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stim;
+
+TEST(BackgroundWriter, runs_tasks_in_order) {
+    std::vector<int> log;
+    BackgroundWriter writer;
+    writer.wait();
+    for (int k = 0; k < 10; k++) {
+        writer.start([&log, k]() {
+            log.push_back(k);
+        });
+    }
+    writer.wait();
+    ASSERT_EQ(log, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(BackgroundWriter, rethrows_exceptions) {
+    BackgroundWriter writer;
+    writer.start([]() {
+        throw std::invalid_argument("test");
+    });
+    ASSERT_THROW({ writer.wait(); }, std::invalid_argument);
+    writer.wait();
+
+    writer.start([]() {
+        throw std::invalid_argument("test");
+    });
+    ASSERT_THROW({ writer.start([]() {}); }, std::invalid_argument);
+    writer.wait();
+
+    // Destructor doesn't throw.
+    BackgroundWriter writer2;
+    writer2.start([]() {
+        throw std::invalid_argument("test");
+    });
+}
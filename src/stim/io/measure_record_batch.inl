@@ -128,7 +128,7 @@ void MeasureRecordBatch<W>::intermediate_write_unwritten_results_to(
 }
 
 template <size_t W>
-void MeasureRecordBatch<W>::final_write_unwritten_results_to(
+void MeasureRecordBatch<W>::flush_unwritten_results_to(
     MeasureRecordBatchWriter &writer, simd_bits_range_ref<W> ref_sample) {
     size_t n = stored;
     for (size_t k = n - unwritten; k < n; k++) {
@@ -143,6 +143,12 @@ void MeasureRecordBatch<W>::final_write_unwritten_results_to(
         written++;
     }
     unwritten = 0;
+}
+
+template <size_t W>
+void MeasureRecordBatch<W>::final_write_unwritten_results_to(
+    MeasureRecordBatchWriter &writer, simd_bits_range_ref<W> ref_sample) {
+    flush_unwritten_results_to(writer, ref_sample);
     writer.write_end();
 }
 
@@ -20,9 +20,10 @@
 
 using namespace stim;
 
-MeasureRecordBatchWriter::MeasureRecordBatchWriter(FILE *out, size_t num_shots, SampleFormat output_format)
+MeasureRecordBatchWriter::MeasureRecordBatchWriter(
+    FILE *out, size_t num_shots, SampleFormat output_format, bool defer_all_output)
     : output_format(output_format), out(out) {
-    if (num_shots > 768) {
+    if (num_shots > MAX_SHOTS) {
         throw std::out_of_range("num_shots > 768 (safety check to ensure staying away from linux file handle limit)");
     }
     if (output_format == SampleFormat::SAMPLE_FORMAT_PTB64 && num_shots % 64 != 0) {
@@ -35,10 +36,10 @@ MeasureRecordBatchWriter::MeasureRecordBatchWriter(FILE *out, size_t num_shots,
         s += 63;
         s /= 64;
     }
-    if (s) {
+    if (s && !defer_all_output) {
         writers.push_back(MeasureRecordWriter::make(out, f));
     }
-    for (size_t k = 1; k < s; k++) {
+    for (size_t k = writers.size(); k < s; k++) {
         FILE *file = tmpfile();
         if (file == nullptr) {
             throw std::out_of_range("Failed to open a temp file.");
@@ -68,12 +69,14 @@ void MeasureRecordBatchWriter::write_end() {
 
     for (FILE *file : temporary_files) {
         rewind(file);
+        // Copy in chunks, instead of with getc/putc, to avoid paying for the file's lock on every byte.
+        char buf[1 << 14];
         while (true) {
-            int c = getc(file);
-            if (c == EOF) {
+            size_t n = fread(buf, 1, sizeof(buf), file);
+            if (n == 0) {
                 break;
             }
-            putc(c, out);
+            fwrite(buf, 1, n, out);
         }
         fclose(file);
     }
@@ -29,10 +29,21 @@ struct MeasureRecordBatchWriter {
     /// Temporary files used to hold data that will eventually be concatenated onto the main stream.
     std::vector<FILE *> temporary_files;
     /// The individual writers for each incoming stream of measurement results.
-    /// The first writer will go directly to `out`, whereas the others go into temporary files.
+    /// The first writer will go directly to `out` (unless `defer_all_output` was set), whereas the others go into
+    /// temporary files.
     std::vector<std::unique_ptr<MeasureRecordWriter>> writers;
 
-    MeasureRecordBatchWriter(FILE *out, size_t num_shots, SampleFormat output_format);
+    /// Safety limit on the number of shots, since each shot may hold a temporary file open.
+    static constexpr size_t MAX_SHOTS = 768;
+
+    /// Args:
+    ///     out: Where the concatenated results are written.
+    ///     num_shots: The number of separate streams of results.
+    ///     output_format: The format to write the results in.
+    ///     defer_all_output: When set, the first stream also goes into a temporary file, so that `out` isn't touched
+    ///         until `write_end` is called. This allows `write_end` to run concurrently with filling up a different
+    ///         writer for the same `out`.
+    MeasureRecordBatchWriter(FILE *out, size_t num_shots, SampleFormat output_format, bool defer_all_output = false);
     /// Cleans up temporary files.
     ~MeasureRecordBatchWriter();
     /// See MeasureRecordWriter::begin_result_type.
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stim/io/measure_record_index.h"
+
+#include <cinttypes>
+#include <sstream>
+
+#include "stim/io/measure_record_reader.h"
+#include "stim/util_bot/str_util.h"
+
+using namespace stim;
+
+uint64_t stim::tell_file_position(FILE *f) {
+#ifdef _WIN32
+    int64_t result = _ftelli64(f);
+#else
+    int64_t result = ftello(f);
+#endif
+    if (result < 0) {
+        throw std::invalid_argument("Failed to get the position of a file. Random access requires a seekable file.");
+    }
+    return (uint64_t)result;
+}
+
+void stim::seek_file_position(FILE *f, uint64_t byte_offset) {
+#ifdef _WIN32
+    int result = _fseeki64(f, (int64_t)byte_offset, SEEK_SET);
+#else
+    int result = fseeko(f, (off_t)byte_offset, SEEK_SET);
+#endif
+    if (result != 0) {
+        throw std::invalid_argument("Failed to seek within a file. Random access requires a seekable file.");
+    }
+}
+
+MeasureRecordIndex::MeasureRecordIndex(uint64_t shots_per_entry)
+    : shots_per_entry(shots_per_entry), num_shots(0), entry_byte_offsets() {
+    if (shots_per_entry == 0) {
+        throw std::invalid_argument("shots_per_entry must be positive.");
+    }
+}
+
+void MeasureRecordIndex::add_shot(uint64_t byte_offset) {
+    if (num_shots % shots_per_entry == 0) {
+        entry_byte_offsets.push_back(byte_offset);
+    }
+    num_shots++;
+}
+
+MeasureRecordIndex MeasureRecordIndex::from_data_file(
+    FILE *in,
+    SampleFormat format,
+    size_t num_measurements,
+    size_t num_detectors,
+    size_t num_observables,
+    uint64_t shots_per_entry) {
+    if (format == SampleFormat::SAMPLE_FORMAT_PTB64 && shots_per_entry % 64 != 0) {
+        throw std::invalid_argument("shots_per_entry must be a multiple of 64 to index ptb64 data.");
+    }
+    MeasureRecordIndex result(shots_per_entry);
+    auto reader = MeasureRecordReader<64>::make(in, format, num_measurements, num_detectors, num_observables);
+    if (reader->expects_empty_serialized_data_for_each_shot()) {
+        throw std::invalid_argument("Can't index shot data that encodes each shot into no bytes.");
+    }
+
+    simd_bits<64> buf(reader->bits_per_record());
+    while (true) {
+        uint64_t pos = tell_file_position(in);
+        if (!reader->start_and_read_entire_record(buf)) {
+            break;
+        }
+        if (format == SampleFormat::SAMPLE_FORMAT_PTB64) {
+            // ptb64 data is loaded 64 shots at a time, so the file position only moves at multiples of 64 shots.
+            for (size_t k = 0; k < 64; k++) {
+                result.add_shot(pos);
+            }
+            for (size_t k = 1; k < 64; k++) {
+                reader->start_and_read_entire_record(buf);
+            }
+        } else {
+            result.add_shot(pos);
+        }
+    }
+    return result;
+}
+
+MeasureRecordIndex MeasureRecordIndex::from_index_file(FILE *in) {
+    uint64_t shots_per_entry;
+    uint64_t num_shots;
+    if (fscanf(in, " shots_per_entry %" SCNu64 " num_shots %" SCNu64, &shots_per_entry, &num_shots) != 2) {
+        throw std::invalid_argument("Index file didn't start with 'shots_per_entry K' and 'num_shots N' lines.");
+    }
+    MeasureRecordIndex result(shots_per_entry);
+    result.num_shots = num_shots;
+    uint64_t num_entries = (num_shots + shots_per_entry - 1) / shots_per_entry;
+    for (uint64_t k = 0; k < num_entries; k++) {
+        uint64_t offset;
+        if (fscanf(in, " %" SCNu64, &offset) != 1) {
+            throw std::invalid_argument(
+                "Index file ended after " + std::to_string(k) + " byte offsets, but num_shots=" +
+                std::to_string(num_shots) + " and shots_per_entry=" + std::to_string(shots_per_entry) +
+                " require " + std::to_string(num_entries) + " byte offsets.");
+        }
+        result.entry_byte_offsets.push_back(offset);
+    }
+    return result;
+}
+
+void MeasureRecordIndex::write_index_file(FILE *out) const {
+    fprintf(out, "shots_per_entry %" PRIu64 "\n", shots_per_entry);
+    fprintf(out, "num_shots %" PRIu64 "\n", num_shots);
+    for (uint64_t offset : entry_byte_offsets) {
+        fprintf(out, "%" PRIu64 "\n", offset);
+    }
+}
+
+bool MeasureRecordIndex::operator==(const MeasureRecordIndex &other) const {
+    return shots_per_entry == other.shots_per_entry && num_shots == other.num_shots &&
+           entry_byte_offsets == other.entry_byte_offsets;
+}
+
+bool MeasureRecordIndex::operator!=(const MeasureRecordIndex &other) const {
+    return !(*this == other);
+}
+
+std::string MeasureRecordIndex::str() const {
+    std::stringstream ss;
+    ss << *this;
+    return ss.str();
+}
+
+std::ostream &stim::operator<<(std::ostream &out, const MeasureRecordIndex &index) {
+    return out << "MeasureRecordIndex{shots_per_entry=" << index.shots_per_entry << ", num_shots=" << index.num_shots
+               << ", entry_byte_offsets={" << comma_sep(index.entry_byte_offsets) << "}}";
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _STIM_IO_MEASURE_RECORD_INDEX_H
+#define _STIM_IO_MEASURE_RECORD_INDEX_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "stim/io/stim_data_formats.h"
+
+namespace stim {
+
+/// Returns the current position of a file, as a byte offset from the start of the file.
+///
+/// Throws:
+///     std::invalid_argument: The file doesn't support seeking (e.g. it's a pipe).
+uint64_t tell_file_position(FILE *f);
+
+/// Moves the current position of a file to the given byte offset from the start of the file.
+///
+/// Throws:
+///     std::invalid_argument: The file doesn't support seeking (e.g. it's a pipe).
+void seek_file_position(FILE *f, uint64_t byte_offset);
+
+/// A sidecar index into a file of shot data, allowing shots to be read starting from the middle of the file.
+///
+/// Most result formats have variable length records, so finding where shot S starts normally requires reading every
+/// shot before it. The index stores the byte offset of every `shots_per_entry`'th shot, so that a reader only has to
+/// seek to the nearest preceding entry and then skip fewer than `shots_per_entry` shots.
+///
+/// The index file format is text. It starts with a line "shots_per_entry K" and a line "num_shots N", followed by
+/// ceil(N / K) lines each containing the byte offset (from the start of the data file) of shot K*i.
+struct MeasureRecordIndex {
+    uint64_t shots_per_entry;
+    uint64_t num_shots;
+    /// The byte offset of shot `k * shots_per_entry` is stored at index k.
+    std::vector<uint64_t> entry_byte_offsets;
+
+    explicit MeasureRecordIndex(uint64_t shots_per_entry);
+
+    /// Notes that another shot is about to be written at the given byte offset of the indexed file.
+    void add_shot(uint64_t byte_offset);
+
+    /// Builds an index by scanning the shot data from the current position of `in` until the end of the file.
+    ///
+    /// Args:
+    ///     in: The shot data to index. Must support seeking.
+    ///     format: The format of the shot data.
+    ///     num_measurements: The number of measurement bits in each shot.
+    ///     num_detectors: The number of detector bits in each shot.
+    ///     num_observables: The number of observable bits in each shot.
+    ///     shots_per_entry: How often to record a byte offset. Must be a multiple of 64 for the ptb64 format.
+    ///
+    /// The split between measurements, detectors, and observables only matters for the dets format, where it
+    /// determines which prefixes ('M', 'D', 'L') are expected.
+    static MeasureRecordIndex from_data_file(
+        FILE *in,
+        SampleFormat format,
+        size_t num_measurements,
+        size_t num_detectors,
+        size_t num_observables,
+        uint64_t shots_per_entry);
+
+    /// Reads an index that was previously written using `write_index_file`.
+    static MeasureRecordIndex from_index_file(FILE *in);
+    /// Writes the index in the text format described in the class docstring.
+    void write_index_file(FILE *out) const;
+
+    bool operator==(const MeasureRecordIndex &other) const;
+    bool operator!=(const MeasureRecordIndex &other) const;
+    std::string str() const;
+};
+
+std::ostream &operator<<(std::ostream &out, const MeasureRecordIndex &index);
+
+}  // namespace stim
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stim/io/measure_record_index.h"
+
+#include "gtest/gtest.h"
+
+#include "stim/io/measure_record_writer.h"
+#include "stim/mem/simd_bits.h"
+#include "stim/util_bot/test_util.test.h"
+
+using namespace stim;
+
+TEST(MeasureRecordIndex, add_shot) {
+    MeasureRecordIndex index(3);
+    ASSERT_EQ(index.num_shots, 0);
+    ASSERT_TRUE(index.entry_byte_offsets.empty());
+    for (uint64_t k = 0; k < 7; k++) {
+        index.add_shot(k * 10);
+    }
+    ASSERT_EQ(index.num_shots, 7);
+    ASSERT_EQ(index.entry_byte_offsets, (std::vector<uint64_t>{0, 30, 60}));
+    ASSERT_EQ(index.str(), "MeasureRecordIndex{shots_per_entry=3, num_shots=7, entry_byte_offsets={0, 30, 60}}");
+
+    ASSERT_THROW({ MeasureRecordIndex(0); }, std::invalid_argument);
+}
+
+TEST(MeasureRecordIndex, index_file_round_trip) {
+    MeasureRecordIndex index(2);
+    index.add_shot(0);
+    index.add_shot(5);
+    index.add_shot(11);
+
+    RaiiTempNamedFile tmp;
+    FILE *f = fopen(tmp.path.c_str(), "wb");
+    index.write_index_file(f);
+    fclose(f);
+    ASSERT_EQ(tmp.read_contents(), "shots_per_entry 2\nnum_shots 3\n0\n11\n");
+
+    f = fopen(tmp.path.c_str(), "rb");
+    ASSERT_EQ(MeasureRecordIndex::from_index_file(f), index);
+    fclose(f);
+
+    tmp.write_contents("shots_per_entry 2\nnum_shots 5\n0\n11\n");
+    f = fopen(tmp.path.c_str(), "rb");
+    ASSERT_THROW({ MeasureRecordIndex::from_index_file(f); }, std::invalid_argument);
+    fclose(f);
+
+    tmp.write_contents("num_shots 5\n0\n11\n");
+    f = fopen(tmp.path.c_str(), "rb");
+    ASSERT_THROW({ MeasureRecordIndex::from_index_file(f); }, std::invalid_argument);
+    fclose(f);
+}
+
+TEST(MeasureRecordIndex, from_data_file_matches_positions_while_writing) {
+    auto rng = INDEPENDENT_TEST_RNG();
+    size_t bits_per_shot = 70;
+    for (const auto &format_data : format_name_to_enum_map()) {
+        SampleFormat format = format_data.second.id;
+        if (format == SampleFormat::SAMPLE_FORMAT_PTB64) {
+            continue;
+        }
+
+        RaiiTempNamedFile tmp;
+        FILE *f = fopen(tmp.path.c_str(), "wb");
+        MeasureRecordIndex expected(4);
+        simd_bits<64> shot(bits_per_shot);
+        for (size_t k = 0; k < 25; k++) {
+            shot.randomize(bits_per_shot, rng);
+            expected.add_shot(tell_file_position(f));
+            auto writer = MeasureRecordWriter::make(f, format);
+            writer->begin_result_type('M');
+            writer->write_bits(shot.u8, bits_per_shot);
+            writer->write_end();
+        }
+        fclose(f);
+
+        f = fopen(tmp.path.c_str(), "rb");
+        ASSERT_EQ(MeasureRecordIndex::from_data_file(f, format, bits_per_shot, 0, 0, 4), expected)
+            << format_data.second.name;
+        fclose(f);
+    }
+}
+
+TEST(MeasureRecordIndex, from_data_file_ptb64) {
+    RaiiTempNamedFile tmp(std::string(3 * 2 * 8, '\0'));
+    FILE *f = fopen(tmp.path.c_str(), "rb");
+    MeasureRecordIndex index = MeasureRecordIndex::from_data_file(f, SampleFormat::SAMPLE_FORMAT_PTB64, 2, 0, 0, 64);
+    fclose(f);
+    ASSERT_EQ(index.num_shots, 192);
+    ASSERT_EQ(index.entry_byte_offsets, (std::vector<uint64_t>{0, 16, 32}));
+
+    f = fopen(tmp.path.c_str(), "rb");
+    ASSERT_THROW(
+        { MeasureRecordIndex::from_data_file(f, SampleFormat::SAMPLE_FORMAT_PTB64, 2, 0, 0, 32); }, std::invalid_argument);
+    fclose(f);
+}
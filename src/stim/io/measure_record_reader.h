@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "stim/io/measure_record_index.h"
 #include "stim/io/sparse_shot.h"
 #include "stim/io/stim_data_formats.h"
 #include "stim/mem/simd_bit_table.h"
@@ -78,6 +79,29 @@ struct MeasureRecordReader {
         size_t num_detectors = 0,
         size_t num_observables = 0);
 
+    /// Creates a MeasureRecordReader that reads a contiguous range of the records in the given FILE*.
+    ///
+    /// Args:
+    ///     in: The file to read from. Must support seeking, unless the range starts at the current position.
+    ///     input_format: The format of the data in the file.
+    ///     record_offset: The number of records to skip before the range starts. For the b8 and ptb64 formats, which
+    ///         have fixed size records, this is done by seeking forward from the current position of `in`. For other
+    ///         formats, this is done by seeking to the nearest preceding entry of `index` (if given) and then reading
+    ///         and discarding the remaining records before the range. Must be a multiple of 64 for ptb64.
+    ///     record_count: The maximum number of records the returned reader will produce. Use UINT64_MAX to read
+    ///         until the end of the file.
+    ///     index: An optional index of the file, used to avoid reading the records before the range.
+    ///     num_measurements, num_detectors, num_observables: Same as for `MeasureRecordReader::make`.
+    static std::unique_ptr<MeasureRecordReader<W>> make_for_record_range(
+        FILE *in,
+        SampleFormat input_format,
+        uint64_t record_offset,
+        uint64_t record_count,
+        const MeasureRecordIndex *index,
+        size_t num_measurements,
+        size_t num_detectors = 0,
+        size_t num_observables = 0);
+
     virtual ~MeasureRecordReader() = default;
 
     /// Determines whether or not there is no actual data written for each shot.
@@ -254,6 +278,29 @@ struct MeasureRecordReaderFormatR8 : MeasureRecordReader<W> {
     bool start_and_read_entire_record_helper(HANDLE_HIT handle_hit);
 };
 
+template <size_t W>
+struct MeasureRecordReaderFormatRice : MeasureRecordReader<W> {
+    FILE *in;
+
+    MeasureRecordReaderFormatRice(FILE *in, size_t num_measurements, size_t num_detectors, size_t num_observables);
+
+    bool start_and_read_entire_record(simd_bits_range_ref<W> dirty_out_buffer) override;
+    bool start_and_read_entire_record(SparseShot &cleared_out) override;
+    bool expects_empty_serialized_data_for_each_shot() const override;
+    size_t read_into_table_with_minor_shot_index(simd_bit_table<W> &out_table, size_t max_shots) override;
+
+   private:
+    /// Bits from the current byte that haven't been decoded yet.
+    uint8_t pending_bits;
+    uint8_t num_pending_bits;
+
+    void load_next_byte();
+    uint64_t decode_bits(uint8_t num_bits);
+    uint64_t decode_unary();
+    template <typename HANDLE_HIT>
+    bool start_and_read_entire_record_helper(HANDLE_HIT handle_hit);
+};
+
 template <size_t W>
 struct MeasureRecordReaderFormatDets : MeasureRecordReader<W> {
     FILE *in;
@@ -271,6 +318,21 @@ struct MeasureRecordReaderFormatDets : MeasureRecordReader<W> {
     bool start_and_read_entire_record_helper(HANDLE_HIT handle_hit);
 };
 
+/// Wraps another reader, stopping after a fixed number of records has been read.
+template <size_t W>
+struct MeasureRecordReaderLimited : MeasureRecordReader<W> {
+    std::unique_ptr<MeasureRecordReader<W>> inner;
+    uint64_t num_unread_records;
+
+    MeasureRecordReaderLimited(std::unique_ptr<MeasureRecordReader<W>> inner, uint64_t max_records);
+
+    bool start_and_read_entire_record(simd_bits_range_ref<W> dirty_out_buffer) override;
+    bool start_and_read_entire_record(SparseShot &cleared_out) override;
+    bool expects_empty_serialized_data_for_each_shot() const override;
+    size_t read_into_table_with_major_shot_index(simd_bit_table<W> &out_table, size_t max_shots) override;
+    size_t read_into_table_with_minor_shot_index(simd_bit_table<W> &out_table, size_t max_shots) override;
+};
+
 template <size_t W>
 size_t read_file_data_into_shot_table(
     FILE *in,
@@ -15,6 +15,7 @@
  */
 
 #include <algorithm>
+#include <bit>
 
 #include "stim/io/measure_record_reader.h"
 
@@ -65,11 +66,58 @@ std::unique_ptr<MeasureRecordReader<W>> MeasureRecordReader<W>::make(
         case SampleFormat::SAMPLE_FORMAT_R8:
             return std::make_unique<MeasureRecordReaderFormatR8<W>>(
                 in, num_measurements, num_detectors, num_observables);
+        case SampleFormat::SAMPLE_FORMAT_RICE:
+            return std::make_unique<MeasureRecordReaderFormatRice<W>>(
+                in, num_measurements, num_detectors, num_observables);
         default:
             throw std::invalid_argument("Sample format not recognized by MeasurementRecordReader");
     }
 }
 
+template <size_t W>
+std::unique_ptr<MeasureRecordReader<W>> MeasureRecordReader<W>::make_for_record_range(
+    FILE *in,
+    SampleFormat input_format,
+    uint64_t record_offset,
+    uint64_t record_count,
+    const MeasureRecordIndex *index,
+    size_t num_measurements,
+    size_t num_detectors,
+    size_t num_observables) {
+    auto reader = make(in, input_format, num_measurements, num_detectors, num_observables);
+    size_t n = reader->bits_per_record();
+    if (input_format == SampleFormat::SAMPLE_FORMAT_PTB64 && record_offset % 64 != 0) {
+        throw std::invalid_argument("The record offset must be a multiple of 64 when using the ptb64 format.");
+    }
+
+    uint64_t num_skipped = 0;
+    if (record_offset > 0) {
+        if (input_format == SampleFormat::SAMPLE_FORMAT_B8) {
+            seek_file_position(in, tell_file_position(in) + record_offset * ((n + 7) >> 3));
+            num_skipped = record_offset;
+        } else if (input_format == SampleFormat::SAMPLE_FORMAT_PTB64) {
+            seek_file_position(in, tell_file_position(in) + record_offset / 64 * n * 8);
+            num_skipped = record_offset;
+        } else if (index != nullptr && !index->entry_byte_offsets.empty()) {
+            uint64_t entry = std::min(
+                record_offset / index->shots_per_entry, (uint64_t)index->entry_byte_offsets.size() - 1);
+            seek_file_position(in, index->entry_byte_offsets[entry]);
+            num_skipped = entry * index->shots_per_entry;
+        }
+    }
+    if (num_skipped < record_offset) {
+        simd_bits<W> discarded(n);
+        while (num_skipped < record_offset && reader->start_and_read_entire_record(discarded)) {
+            num_skipped++;
+        }
+    }
+
+    if (record_count == UINT64_MAX) {
+        return reader;
+    }
+    return std::make_unique<MeasureRecordReaderLimited<W>>(std::move(reader), record_count);
+}
+
 template <size_t W>
 size_t MeasureRecordReader<W>::bits_per_record() const {
     return num_measurements + num_detectors + num_observables;
@@ -475,6 +523,148 @@ bool MeasureRecordReaderFormatR8<W>::start_and_read_entire_record_helper(HANDLE_
     }
 }
 
+/// Rice format
+
+template <size_t W>
+MeasureRecordReaderFormatRice<W>::MeasureRecordReaderFormatRice(
+    FILE *in, size_t num_measurements, size_t num_detectors, size_t num_observables)
+    : MeasureRecordReader<W>(num_measurements, num_detectors, num_observables),
+      in(in),
+      pending_bits(0),
+      num_pending_bits(0) {
+}
+
+template <size_t W>
+bool MeasureRecordReaderFormatRice<W>::start_and_read_entire_record(simd_bits_range_ref<W> dirty_out_buffer) {
+    dirty_out_buffer.prefix_ref(this->bits_per_record()).clear();
+    return start_and_read_entire_record_helper([&](size_t bit_index) {
+        dirty_out_buffer[bit_index] = 1;
+    });
+}
+
+template <size_t W>
+bool MeasureRecordReaderFormatRice<W>::start_and_read_entire_record(SparseShot &cleared_out) {
+    if (cleared_out.obs_mask.num_bits_padded() < this->num_observables) {
+        cleared_out.obs_mask = simd_bits<64>(this->num_observables);
+    }
+    bool result = start_and_read_entire_record_helper([&](size_t bit_index) {
+        cleared_out.hits.push_back(bit_index);
+    });
+    this->move_obs_in_shots_to_mask_assuming_sorted(cleared_out);
+    return result;
+}
+
+template <size_t W>
+bool MeasureRecordReaderFormatRice<W>::expects_empty_serialized_data_for_each_shot() const {
+    return false;
+}
+
+template <size_t W>
+size_t MeasureRecordReaderFormatRice<W>::read_into_table_with_minor_shot_index(
+    simd_bit_table<W> &out_table, size_t max_shots) {
+    size_t read_shots = 0;
+    out_table.clear();
+    while (read_shots < max_shots) {
+        bool more = start_and_read_entire_record_helper([&](size_t bit_index) {
+            out_table[bit_index][read_shots] |= 1;
+        });
+        if (!more) {
+            break;
+        }
+        read_shots++;
+    }
+    return read_shots;
+}
+
+template <size_t W>
+void MeasureRecordReaderFormatRice<W>::load_next_byte() {
+    int next_char = getc(in);
+    if (next_char == EOF) {
+        throw std::invalid_argument(
+            "End of file before end of rice data. Expected to decode " + std::to_string(this->bits_per_record()) +
+            " bits.");
+    }
+    pending_bits = (uint8_t)next_char;
+    num_pending_bits = 8;
+}
+
+template <size_t W>
+uint64_t MeasureRecordReaderFormatRice<W>::decode_bits(uint8_t num_bits) {
+    uint64_t result = 0;
+    uint8_t num_decoded = 0;
+    while (num_decoded < num_bits) {
+        if (num_pending_bits == 0) {
+            load_next_byte();
+        }
+        uint8_t n = std::min((uint8_t)(num_bits - num_decoded), num_pending_bits);
+        result |= (uint64_t)(pending_bits & ((1 << n) - 1)) << num_decoded;
+        pending_bits >>= n;
+        num_pending_bits -= n;
+        num_decoded += n;
+    }
+    return result;
+}
+
+template <size_t W>
+uint64_t MeasureRecordReaderFormatRice<W>::decode_unary() {
+    uint64_t result = 0;
+    while (true) {
+        if (num_pending_bits == 0) {
+            load_next_byte();
+        }
+        uint8_t ones = (uint8_t)std::countr_one(pending_bits);
+        if (ones < num_pending_bits) {
+            result += ones;
+            pending_bits >>= ones + 1;
+            num_pending_bits -= ones + 1;
+            return result;
+        }
+        result += num_pending_bits;
+        num_pending_bits = 0;
+    }
+}
+
+template <size_t W>
+template <typename HANDLE_HIT>
+bool MeasureRecordReaderFormatRice<W>::start_and_read_entire_record_helper(HANDLE_HIT handle_hit) {
+    // Shots always start on a byte boundary. Discard the padding from the previous shot.
+    num_pending_bits = 0;
+    int next_char = getc(in);
+    if (next_char == EOF) {
+        return false;
+    }
+    pending_bits = (uint8_t)next_char;
+    num_pending_bits = 8;
+
+    size_t n = this->bits_per_record();
+    uint8_t k = (uint8_t)decode_bits(6);
+    size_t pos = 0;
+    while (true) {
+        uint64_t q = decode_unary();
+        uint64_t r = 0;
+        if (k > 32) {
+            r = decode_bits(32);
+            r |= decode_bits(k - 32) << 32;
+        } else {
+            r = decode_bits(k);
+        }
+        if (k > 0 && (q >> (64 - k)) != 0) {
+            throw std::invalid_argument("rice data encoded a gap that doesn't fit into 64 bits.");
+        }
+        pos += (q << k) | r;
+        if (pos < n) {
+            handle_hit(pos);
+            pos++;
+        } else if (pos == n) {
+            return true;
+        } else {
+            throw std::invalid_argument(
+                "rice data jumped past expected end of encoded data. Expected to decode " +
+                std::to_string(this->bits_per_record()) + " bits.");
+        }
+    }
+}
+
 /// DETS format
 
 template <size_t W>
@@ -758,6 +948,57 @@ size_t MeasureRecordReaderFormatPTB64<W>::read_into_table_with_major_shot_index(
     return max_shots;
 }
 
+/// Limited reader
+
+template <size_t W>
+MeasureRecordReaderLimited<W>::MeasureRecordReaderLimited(
+    std::unique_ptr<MeasureRecordReader<W>> inner, uint64_t max_records)
+    : MeasureRecordReader<W>(inner->num_measurements, inner->num_detectors, inner->num_observables),
+      inner(std::move(inner)),
+      num_unread_records(max_records) {
+}
+
+template <size_t W>
+bool MeasureRecordReaderLimited<W>::start_and_read_entire_record(simd_bits_range_ref<W> dirty_out_buffer) {
+    if (num_unread_records == 0 || !inner->start_and_read_entire_record(dirty_out_buffer)) {
+        return false;
+    }
+    num_unread_records--;
+    return true;
+}
+
+template <size_t W>
+bool MeasureRecordReaderLimited<W>::start_and_read_entire_record(SparseShot &cleared_out) {
+    if (num_unread_records == 0 || !inner->start_and_read_entire_record(cleared_out)) {
+        return false;
+    }
+    num_unread_records--;
+    return true;
+}
+
+template <size_t W>
+bool MeasureRecordReaderLimited<W>::expects_empty_serialized_data_for_each_shot() const {
+    return inner->expects_empty_serialized_data_for_each_shot();
+}
+
+template <size_t W>
+size_t MeasureRecordReaderLimited<W>::read_into_table_with_major_shot_index(
+    simd_bit_table<W> &out_table, size_t max_shots) {
+    size_t n = inner->read_into_table_with_major_shot_index(
+        out_table, (size_t)std::min((uint64_t)max_shots, num_unread_records));
+    num_unread_records -= n;
+    return n;
+}
+
+template <size_t W>
+size_t MeasureRecordReaderLimited<W>::read_into_table_with_minor_shot_index(
+    simd_bit_table<W> &out_table, size_t max_shots) {
+    size_t n = inner->read_into_table_with_minor_shot_index(
+        out_table, (size_t)std::min((uint64_t)max_shots, num_unread_records));
+    num_unread_records -= n;
+    return n;
+}
+
 template <size_t W>
 size_t read_file_data_into_shot_table(
     FILE *in,
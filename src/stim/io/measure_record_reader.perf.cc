@@ -128,3 +128,16 @@ BENCHMARK(read_r8_sparse_per10) {
 BENCHMARK(read_r8_sparse_per100) {
     sparse_reader_benchmark<10000, 100, SampleFormat::SAMPLE_FORMAT_R8>(1.0);
 }
+
+BENCHMARK(read_rice_dense_per10) {
+    dense_reader_benchmark<10000, 10, SampleFormat::SAMPLE_FORMAT_RICE>(10);
+}
+BENCHMARK(read_rice_dense_per100) {
+    dense_reader_benchmark<10000, 100, SampleFormat::SAMPLE_FORMAT_RICE>(1.5);
+}
+BENCHMARK(read_rice_sparse_per10) {
+    sparse_reader_benchmark<10000, 10, SampleFormat::SAMPLE_FORMAT_RICE>(8);
+}
+BENCHMARK(read_rice_sparse_per100) {
+    sparse_reader_benchmark<10000, 100, SampleFormat::SAMPLE_FORMAT_RICE>(1.2);
+}
@@ -114,6 +114,30 @@ TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatR8_LongGap, {
     ASSERT_FALSE(reader->start_and_read_entire_record(sparse));
 })
 
+TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatRice, {
+    assert_contents_load_correctly<W>(SampleFormat::SAMPLE_FORMAT_RICE, std::string("\xC0\xC1\x03\x00", 4));
+})
+
+TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatRice_LongGap, {
+    FILE *tmp = tmpfile_with_contents(std::string("\xCB\x01\x1D\x06\x00", 5));
+    auto reader = MeasureRecordReader<W>::make(tmp, SampleFormat::SAMPLE_FORMAT_RICE, 8000 + 1 + 24);
+    SparseShot sparse;
+    ASSERT_TRUE(reader->start_and_read_entire_record(sparse));
+    ASSERT_EQ(sparse.hits, (std::vector<uint64_t>{8000}));
+    ASSERT_FALSE(reader->start_and_read_entire_record(sparse));
+})
+
+TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatRice_InvalidInput, {
+    simd_bits<W> buf(8);
+    FILE *tmp = tmpfile_with_contents(std::string("\x00\xFF", 2));
+    auto reader = MeasureRecordReader<W>::make(tmp, SampleFormat::SAMPLE_FORMAT_RICE, 8);
+    ASSERT_THROW({ reader->start_and_read_entire_record(buf); }, std::invalid_argument);
+
+    tmp = tmpfile_with_contents(std::string("\x00\x7F", 2));
+    reader = MeasureRecordReader<W>::make(tmp, SampleFormat::SAMPLE_FORMAT_RICE, 8);
+    ASSERT_THROW({ reader->start_and_read_entire_record(buf); }, std::invalid_argument);
+})
+
 FILE *write_records(SpanRef<const uint8_t> data, SampleFormat format) {
     FILE *tmp = tmpfile();
     auto writer = MeasureRecordWriter::make(tmp, format);
@@ -179,6 +203,20 @@ TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatR8_WriteRead, {
     }
 })
 
+TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatRice_WriteRead, {
+    uint8_t src[]{0, 1, 2, 3, 4, 0xFF, 0xBF, 0xFE, 80, 0, 0, 1, 20};
+    constexpr size_t num_bytes = sizeof(src) / sizeof(uint8_t);
+    uint8_t dst[num_bytes]{};
+    FILE *tmp = write_records({src, src + num_bytes}, SampleFormat::SAMPLE_FORMAT_RICE);
+    rewind(tmp);
+    ASSERT_EQ(
+        num_bytes * 8,
+        read_records_as_bytes<W>(tmp, {dst, dst + num_bytes}, SampleFormat::SAMPLE_FORMAT_RICE, 8 * num_bytes));
+    for (size_t i = 0; i < num_bytes; ++i) {
+        ASSERT_EQ(src[i], dst[i]);
+    }
+})
+
 TEST_EACH_WORD_SIZE_W(MeasureRecordReader, FormatHits_WriteRead, {
     uint8_t src[]{0, 1, 2, 3, 4, 0xFF, 0xBF, 0xFE, 80, 0, 0, 1, 20};
     constexpr size_t num_bytes = sizeof(src) / sizeof(uint8_t);
@@ -818,3 +856,73 @@ TEST_EACH_WORD_SIZE_W(MeasureRecordReader, read_windows_newlines_dets, {
     ASSERT_EQ(read[3][1], false);
     fclose(f);
 })
+
+TEST_EACH_WORD_SIZE_W(MeasureRecordReader, make_for_record_range, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    for (const auto &format_data : format_name_to_enum_map()) {
+        SampleFormat format = format_data.second.id;
+        size_t num_shots = 300;
+        size_t shot_offset = 37;
+        size_t shot_count = 50;
+        size_t shots_per_entry = 16;
+        if (format == SampleFormat::SAMPLE_FORMAT_PTB64) {
+            num_shots = 320;
+            shot_offset = 64;
+            shot_count = 128;
+            shots_per_entry = 64;
+        }
+        size_t bits_per_shot = 100;
+
+        simd_bit_table<W> expected(num_shots, bits_per_shot);
+        for (size_t shot = 0; shot < num_shots; shot++) {
+            expected[shot].randomize(bits_per_shot, rng);
+        }
+        RaiiTempNamedFile tmp;
+        FILE *f = fopen(tmp.path.c_str(), "wb");
+        write_table_data<W>(f, num_shots, bits_per_shot, simd_bits<W>(0), expected.transposed(), format, 'M', 'M', 0);
+        fclose(f);
+
+        f = fopen(tmp.path.c_str(), "rb");
+        MeasureRecordIndex index = MeasureRecordIndex::from_data_file(f, format, bits_per_shot, 0, 0, shots_per_entry);
+        fclose(f);
+        ASSERT_EQ(index.num_shots, num_shots) << format_data.second.name;
+
+        for (const MeasureRecordIndex *index_ptr : std::vector<const MeasureRecordIndex *>{nullptr, &index}) {
+            f = fopen(tmp.path.c_str(), "rb");
+            auto reader =
+                MeasureRecordReader<W>::make_for_record_range(f, format, shot_offset, shot_count, index_ptr, bits_per_shot);
+            simd_bits<W> buf(bits_per_shot);
+            for (size_t k = 0; k < shot_count; k++) {
+                ASSERT_TRUE(reader->start_and_read_entire_record(buf)) << format_data.second.name;
+                ASSERT_EQ(buf, expected[shot_offset + k]) << format_data.second.name << " shot " << k;
+            }
+            ASSERT_FALSE(reader->start_and_read_entire_record(buf)) << format_data.second.name;
+            fclose(f);
+
+            f = fopen(tmp.path.c_str(), "rb");
+            reader = MeasureRecordReader<W>::make_for_record_range(
+                f, format, shot_offset, shot_count, index_ptr, bits_per_shot);
+            simd_bit_table<W> table(num_shots, bits_per_shot);
+            ASSERT_EQ(reader->read_records_into(table, true), shot_count) << format_data.second.name;
+            for (size_t k = 0; k < shot_count; k++) {
+                ASSERT_EQ(table[k], expected[shot_offset + k]) << format_data.second.name << " shot " << k;
+            }
+            fclose(f);
+        }
+    }
+})
+
+TEST_EACH_WORD_SIZE_W(MeasureRecordReader, make_for_record_range_past_end, {
+    FILE *f = tmpfile_with_contents("0\n1\n");
+    auto reader = MeasureRecordReader<W>::make_for_record_range(f, SampleFormat::SAMPLE_FORMAT_01, 1, 5, nullptr, 1);
+    simd_bits<W> buf(1);
+    ASSERT_TRUE(reader->start_and_read_entire_record(buf));
+    ASSERT_TRUE(buf[0]);
+    ASSERT_FALSE(reader->start_and_read_entire_record(buf));
+    fclose(f);
+
+    f = tmpfile_with_contents("0\n1\n");
+    reader = MeasureRecordReader<W>::make_for_record_range(f, SampleFormat::SAMPLE_FORMAT_01, 3, 1, nullptr, 1);
+    ASSERT_FALSE(reader->start_and_read_entire_record(buf));
+    fclose(f);
+})
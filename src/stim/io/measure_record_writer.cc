@@ -17,9 +17,44 @@
 #include "stim/io/measure_record_writer.h"
 
 #include <algorithm>
+#include <bit>
 
 using namespace stim;
 
+/// Writes a single character without taking the file's lock.
+///
+/// Once a process has started a second thread (e.g. a BackgroundWriter), 'putc' locks the file on every call, which
+/// is a large fraction of the cost of writing text formats. A file is only ever written by one writer at a time, so
+/// the locking isn't needed.
+static inline void put_char_unlocked(int c, FILE *out) {
+#ifdef _WIN32
+    _putc_nolock(c, out);
+#else
+    putc_unlocked(c, out);
+#endif
+}
+
+/// Writes the decimal digits of an integer without taking the file's lock.
+static inline void put_uint_unlocked(uint64_t value, FILE *out) {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[n++] = '0' + (char)(value % 10);
+        value /= 10;
+    } while (value);
+    while (n) {
+        put_char_unlocked(digits[--n], out);
+    }
+}
+
+/// Writes the text "shot" without taking the file's lock.
+static inline void put_shot_prefix_unlocked(FILE *out) {
+    put_char_unlocked('s', out);
+    put_char_unlocked('h', out);
+    put_char_unlocked('o', out);
+    put_char_unlocked('t', out);
+}
+
 std::unique_ptr<MeasureRecordWriter> MeasureRecordWriter::make(FILE *out, SampleFormat output_format) {
     switch (output_format) {
         case SampleFormat::SAMPLE_FORMAT_01:
@@ -34,6 +69,8 @@ std::unique_ptr<MeasureRecordWriter> MeasureRecordWriter::make(FILE *out, Sample
             throw std::invalid_argument("SAMPLE_FORMAT_PTB64 incompatible with SingleMeasurementRecord");
         case SampleFormat::SAMPLE_FORMAT_R8:
             return std::make_unique<MeasureRecordWriterFormatR8>(out);
+        case SampleFormat::SAMPLE_FORMAT_RICE:
+            return std::make_unique<MeasureRecordWriterFormatRice>(out);
         default:
             throw std::invalid_argument("Sample format not recognized by SingleMeasurementRecord");
     }
@@ -62,11 +99,11 @@ MeasureRecordWriterFormat01::MeasureRecordWriterFormat01(FILE *out) : out(out) {
 }
 
 void MeasureRecordWriterFormat01::write_bit(bool b) {
-    putc('0' + b, out);
+    put_char_unlocked('0' + b, out);
 }
 
 void MeasureRecordWriterFormat01::write_end() {
-    putc('\n', out);
+    put_char_unlocked('\n', out);
 }
 
 MeasureRecordWriterFormatB8::MeasureRecordWriterFormatB8(FILE *out) : out(out) {
@@ -84,7 +121,7 @@ void MeasureRecordWriterFormatB8::write_bit(bool b) {
     payload |= uint8_t{b} << count;
     count++;
     if (count == 8) {
-        putc(payload, out);
+        put_char_unlocked(payload, out);
         count = 0;
         payload = 0;
     }
@@ -92,7 +129,7 @@ void MeasureRecordWriterFormatB8::write_bit(bool b) {
 
 void MeasureRecordWriterFormatB8::write_end() {
     if (count > 0) {
-        putc(payload, out);
+        put_char_unlocked(payload, out);
         count = 0;
         payload = 0;
     }
@@ -118,15 +155,15 @@ void MeasureRecordWriterFormatHits::write_bit(bool b) {
         if (first) {
             first = false;
         } else {
-            putc(',', out);
+            put_char_unlocked(',', out);
         }
-        fprintf(out, "%lld", (unsigned long long)(position));
+        put_uint_unlocked(position, out);
     }
     position++;
 }
 
 void MeasureRecordWriterFormatHits::write_end() {
-    putc('\n', out);
+    put_char_unlocked('\n', out);
     position = 0;
     first = true;
 }
@@ -139,7 +176,7 @@ void MeasureRecordWriterFormatR8::write_bytes(SpanRef<const uint8_t> data) {
         if (!b) {
             run_length += 8;
             if (run_length >= 0xFF) {
-                putc(0xFF, out);
+                put_char_unlocked(0xFF, out);
                 run_length -= 0xFF;
             }
         } else {
@@ -152,22 +189,101 @@ void MeasureRecordWriterFormatR8::write_bytes(SpanRef<const uint8_t> data) {
 
 void MeasureRecordWriterFormatR8::write_bit(bool b) {
     if (b) {
-        putc(run_length, out);
+        put_char_unlocked(run_length, out);
         run_length = 0;
     } else {
         run_length++;
         if (run_length == 255) {
-            putc(run_length, out);
+            put_char_unlocked(run_length, out);
             run_length = 0;
         }
     }
 }
 
 void MeasureRecordWriterFormatR8::write_end() {
-    putc(run_length, out);
+    put_char_unlocked(run_length, out);
     run_length = 0;
 }
 
+MeasureRecordWriterFormatRice::MeasureRecordWriterFormatRice(FILE *out) : out(out) {
+}
+
+void MeasureRecordWriterFormatRice::write_bytes(SpanRef<const uint8_t> data) {
+    for (uint8_t b : data) {
+        if (!b) {
+            position += 8;
+        } else {
+            for (size_t k = 0; k < 8; k++) {
+                write_bit((b >> k) & 1);
+            }
+        }
+    }
+}
+
+void MeasureRecordWriterFormatRice::write_bit(bool b) {
+    if (b) {
+        gaps.push_back(position - run_start);
+        run_start = position + 1;
+    }
+    position++;
+}
+
+void MeasureRecordWriterFormatRice::encode_bits(uint64_t bits, uint8_t num_bits) {
+    // Callers never pass more than 32 bits at a time, so the 64 bit buffer can't overflow.
+    pending_bits |= bits << num_pending_bits;
+    num_pending_bits += num_bits;
+    while (num_pending_bits >= 8) {
+        put_char_unlocked((uint8_t)pending_bits, out);
+        pending_bits >>= 8;
+        num_pending_bits -= 8;
+    }
+}
+
+void MeasureRecordWriterFormatRice::write_end() {
+    // The shot is terminated by an implicit True bit just past its end.
+    gaps.push_back(position - run_start);
+
+    // Pick the rice parameter that minimizes the encoded size of the shot.
+    uint64_t max_gap = *std::max_element(gaps.begin(), gaps.end());
+    uint8_t best_k = 0;
+    uint64_t best_cost = UINT64_MAX;
+    for (uint8_t k = 0; k <= (uint8_t)std::bit_width(max_gap) && k < 64; k++) {
+        uint64_t cost = gaps.size() * (uint64_t)(1 + k);
+        for (uint64_t g : gaps) {
+            cost += g >> k;
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_k = k;
+        }
+    }
+
+    encode_bits(best_k, 6);
+    for (uint64_t g : gaps) {
+        uint64_t q = g >> best_k;
+        while (q >= 32) {
+            encode_bits(0xFFFFFFFF, 32);
+            q -= 32;
+        }
+        encode_bits((uint64_t{1} << q) - 1, (uint8_t)q + 1);
+        uint64_t r = g;
+        uint8_t k = best_k;
+        while (k > 32) {
+            encode_bits(r & 0xFFFFFFFF, 32);
+            r >>= 32;
+            k -= 32;
+        }
+        encode_bits(r & ((uint64_t{1} << k) - 1), k);
+    }
+    if (num_pending_bits) {
+        encode_bits(0, 8 - num_pending_bits);
+    }
+
+    gaps.clear();
+    position = 0;
+    run_start = 0;
+}
+
 MeasureRecordWriterFormatDets::MeasureRecordWriterFormatDets(FILE *out) : out(out) {
 }
 
@@ -191,21 +307,21 @@ void MeasureRecordWriterFormatDets::write_bytes(SpanRef<const uint8_t> data) {
 void MeasureRecordWriterFormatDets::write_bit(bool b) {
     if (b) {
         if (first) {
-            fprintf(out, "shot");
+            put_shot_prefix_unlocked(out);
             first = false;
         }
-        putc(' ', out);
-        putc(result_type, out);
-        fprintf(out, "%lld", (unsigned long long)(position));
+        put_char_unlocked(' ', out);
+        put_char_unlocked(result_type, out);
+        put_uint_unlocked(position, out);
     }
     position++;
 }
 
 void MeasureRecordWriterFormatDets::write_end() {
     if (first) {
-        fprintf(out, "shot");
+        put_shot_prefix_unlocked(out);
     }
-    putc('\n', out);
+    put_char_unlocked('\n', out);
     position = 0;
     first = true;
 }
@@ -18,6 +18,7 @@
 #define _STIM_IO_MEASURE_RECORD_WRITER_H
 
 #include <memory>
+#include <vector>
 
 #include "stim/io/stim_data_formats.h"
 #include "stim/mem/simd_bit_table.h"
@@ -85,6 +86,25 @@ struct MeasureRecordWriterFormatR8 : MeasureRecordWriter {
     void write_end() override;
 };
 
+struct MeasureRecordWriterFormatRice : MeasureRecordWriter {
+    FILE *out;
+    uint64_t position = 0;
+    uint64_t run_start = 0;
+    /// The lengths of the runs of False bits preceding each True bit of the current shot.
+    std::vector<uint64_t> gaps;
+    /// Bits that have been encoded but not yet written out as a full byte.
+    uint64_t pending_bits = 0;
+    uint8_t num_pending_bits = 0;
+
+    MeasureRecordWriterFormatRice(FILE *out);
+    void write_bytes(SpanRef<const uint8_t> data) override;
+    void write_bit(bool b) override;
+    void write_end() override;
+
+   private:
+    void encode_bits(uint64_t bits, uint8_t num_bits);
+};
+
 struct MeasureRecordWriterFormatDets : MeasureRecordWriter {
     FILE *out;
     uint64_t position = 0;
@@ -164,6 +164,31 @@ TEST(MeasureRecordWriter, FormatR8_LongGap) {
     ASSERT_EQ(s[3], (char)32);
 }
 
+TEST(MeasureRecordWriter, FormatRice) {
+    FILE *tmp = tmpfile();
+    auto writer = MeasureRecordWriter::make(tmp, SampleFormat::SAMPLE_FORMAT_RICE);
+    uint8_t bytes[]{0xF8};
+    writer->write_bytes({bytes});
+    writer->write_bit(false);
+    writer->write_bytes({bytes});
+    writer->write_bit(true);
+    writer->write_end();
+    // Rice parameter 0, then the run lengths 3,0,0,0,0,4,0,0,0,0,0,0 in unary.
+    ASSERT_EQ(rewind_read_close(tmp), std::string("\xC0\xC1\x03\x00", 4));
+}
+
+TEST(MeasureRecordWriter, FormatRice_LongGap) {
+    FILE *tmp = tmpfile();
+    auto writer = MeasureRecordWriter::make(tmp, SampleFormat::SAMPLE_FORMAT_RICE);
+    std::vector<uint8_t> bytes(1000);
+    writer->write_bytes({bytes.data(), bytes.data() + bytes.size()});
+    writer->write_bit(true);
+    writer->write_bytes({bytes.data(), bytes.data() + 3});
+    writer->write_end();
+    writer->write_end();
+    ASSERT_EQ(rewind_read_close(tmp), std::string("\xCB\x01\x1D\x06\x00\x00", 6));
+}
+
 TEST_EACH_WORD_SIZE_W(MeasureRecordWriter, write_table_data_small, {
     simd_bit_table<W> results(4, 5);
     simd_bits<W> ref_sample(0);
@@ -432,6 +457,15 @@ TEST(MeasureRecordWriter, write_bits_r8_a) {
     ASSERT_EQ(rewind_read_close(f), std::string("\x08\x00\x00\x00", 4));
 }
 
+TEST(MeasureRecordWriter, write_bits_rice) {
+    FILE *f = tmpfile();
+    uint8_t data[]{0x0, 0xFF};
+    auto writer = MeasureRecordWriter::make(f, SampleFormat::SAMPLE_FORMAT_RICE);
+    writer->write_bits(&data[0], 11);
+    writer->write_end();
+    ASSERT_EQ(rewind_read_close(f), std::string("\xC0\x3F\x00", 3));
+}
+
 TEST(MeasureRecordWriter, write_bits_r8_b) {
     FILE *f = tmpfile();
     uint8_t data[]{0xFF, 0x0};
@@ -273,7 +273,7 @@ def test_read_01_shots():
 
 
 @pytest.mark.parametrize("data_format,bit_packed,path_type", itertools.product(
-    ["01", "b8", "r8", "ptb64", "hits", "dets"],
+    ["01", "b8", "r8", "rice", "ptb64", "hits", "dets"],
     [False, True],
     ["str", "path"]))
 def test_read_write_shots_fuzzing(data_format: str, bit_packed: bool, path_type: str):
@@ -309,7 +309,7 @@ def test_read_write_shots_fuzzing(data_format: str, bit_packed: bool, path_type:
 
 
 @pytest.mark.parametrize("data_format,num_bits_per_shot", itertools.product(
-    ["01", "b8", "r8", "ptb64", "hits", "dets"],
+    ["01", "b8", "r8", "rice", "ptb64", "hits", "dets"],
     [11, 511, 512, 513],
 ))
 def test_read_write_shots_fuzzing_vs_python_references(data_format: str, num_bits_per_shot: int):
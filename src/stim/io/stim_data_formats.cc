@@ -363,6 +363,112 @@ def parse_r8(data: bytes, bits_per_shot: int) -> List[List[bool]]:
             },
         },
 
+        {
+            "rice",
+            FileFormatData{
+                "rice",
+                SampleFormat::SAMPLE_FORMAT_RICE,
+                R"HELP(
+The rice format is a sparse binary format that stores shots as golomb-rice coded lengths of runs between 1s.
+
+Like the r8 format, a shot always has a terminating True bit appended to it before encoding, and the shot is described
+by the number of False bits before each True bit. Unlike the r8 format, these run lengths are written as a stream of
+bits (packed into bytes in significance order, like the b8 format) using a golomb-rice code whose parameter is picked
+separately for each shot. This makes the size of the encoded data close to optimal whether the True bits are very
+sparse (e.g. detection events at low noise) or moderately dense.
+
+Each shot starts on a byte boundary. The first 6 bits of the shot are the rice parameter k, stored in significance
+order. Each run length g is then encoded as (g >> k) 1 bits, followed by a 0 bit, followed by the low k bits of g (in
+significance order). Decoding of the shot ends when the terminating True bit just past the end of the shot data is
+reached. Any remaining bits in the last byte of the shot are padding and are set to 0.
+
+This format requires the reader to know the number of bits in each shot.
+
+This format is useful in contexts where the number of set bits is expected to be low, e.g. when sampling detection
+events, and storage or bandwidth is at a premium.
+
+*Example of producing rice format data using stim's python API:*
+
+    >>> import pathlib
+    >>> import stim
+    >>> import tempfile
+    >>> with tempfile.TemporaryDirectory() as d:
+    ...     path = str(pathlib.Path(d) / "tmp.dat")
+    ...     stim.Circuit("""
+    ...         X 1
+    ...         M 0 0 0 0 1 1 1 1 0 0 1 1 0 1
+    ...     """).compile_sampler().sample_write(shots=10, filepath=path, format="rice")
+    ...     with open(path, 'rb') as f:
+    ...         print(' '.join(hex(e)[2:] for e in f.read()))
+    c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4 c0 c3 4
+
+    >>> with tempfile.TemporaryDirectory() as d:
+    ...     path = str(pathlib.Path(d) / "tmp.dat")
+    ...     stim.Circuit("""
+    ...         X 1
+    ...         M 0 0 0 0 0 0 0 0 0 1 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0
+    ...     """).compile_sampler().sample_write(shots=10, filepath=path, format="rice")
+    ...     with open(path, 'rb') as f:
+    ...         print(' '.join(hex(e)[2:] for e in f.read()))
+    84 ec 1 84 ec 1 84 ec 1 84 ec 1 84 ec 1 84 ec 1 84 ec 1 84 ec 1 84 ec 1 84 ec 1
+)HELP",
+                R"PYTHON(
+from typing import List
+
+def save_rice(shots: List[List[bool]]) -> bytes:
+    output = []
+    for shot in shots:
+        gaps = []
+        gap = 0
+        for b in list(shot) + [True]:
+            if b:
+                gaps.append(gap)
+                gap = 0
+            else:
+                gap += 1
+        k = min(range(64), key=lambda k: sum((g >> k) + 1 + k for g in gaps))
+
+        bits = [(k >> i) & 1 for i in range(6)]
+        for g in gaps:
+            bits += [1] * (g >> k) + [0]
+            bits += [(g >> i) & 1 for i in range(k)]
+        while len(bits) % 8:
+            bits.append(0)
+        for i in range(0, len(bits), 8):
+            output.append(sum(bits[i + j] << j for j in range(8)))
+    return bytes(output)
+)PYTHON",
+                R"PYTHON(
+from typing import List
+
+def parse_rice(data: bytes, bits_per_shot: int) -> List[List[bool]]:
+    bits = [(byte >> i) & 1 for byte in data for i in range(8)]
+    shots = []
+    i = 0
+    while i < len(bits):
+        k = sum(bits[i + j] << j for j in range(6))
+        i += 6
+        shot = []
+        while True:
+            q = 0
+            while bits[i]:
+                q += 1
+                i += 1
+            i += 1
+            r = sum(bits[i + j] << j for j in range(k))
+            i += k
+            shot += [False] * ((q << k) + r)
+            if len(shot) == bits_per_shot:
+                break
+            assert len(shot) < bits_per_shot
+            shot.append(True)
+        shots.append(shot)
+        i += -i % 8
+    return shots
+)PYTHON",
+            },
+        },
+
         {
             "dets",
             FileFormatData{
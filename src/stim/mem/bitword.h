@@ -39,6 +39,14 @@ inline bool operator==(const bitword<W> &self, const bitword<W> &other) {
     return self.to_u64_array() == other.to_u64_array();
 }
 
+/// Returns a ^ b ^ c.
+///
+/// Widths with a three-input logic instruction overload this, so that the xor happens in one instruction.
+template <size_t W>
+inline bitword<W> xor3(const bitword<W> &a, const bitword<W> &b, const bitword<W> &c) {
+    return a ^ b ^ c;
+}
+
 template <size_t W>
 inline bool operator<(const bitword<W> &self, const bitword<W> &other) {
     auto v1 = self.to_u64_array();
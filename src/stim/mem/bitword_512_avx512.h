@@ -0,0 +1,278 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _STIM_MEM_SIMD_WORD_512_AVX512_H
+#define _STIM_MEM_SIMD_WORD_512_AVX512_H
+#if __AVX512F__
+
+#include <array>
+#include <bit>
+#include <immintrin.h>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "stim/mem/bitword.h"
+#include "stim/mem/simd_util.h"
+
+namespace stim {
+
+/// Implements a 512 bit bitword using AVX-512 instructions.
+template <>
+struct bitword<512> {
+    constexpr static size_t BIT_SIZE = 512;
+    constexpr static size_t BIT_POW = 9;
+
+    union {
+        __m512i val;
+        uint8_t u8[64];
+    };
+
+    static void *aligned_malloc(size_t bytes) {
+        return _mm_malloc(bytes, sizeof(__m512i));
+    }
+    static void aligned_free(void *ptr) {
+        _mm_free(ptr);
+    }
+
+    inline bitword<512>() : val(_mm512_setzero_si512()) {
+    }
+    inline bitword<512>(__m512i val) : val(val) {
+    }
+    inline bitword<512>(std::array<uint64_t, 8> val)
+        : val{_mm512_set_epi64(val[7], val[6], val[5], val[4], val[3], val[2], val[1], val[0])} {
+    }
+    inline bitword<512>(uint64_t val) : val{_mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, val)} {
+    }
+    inline bitword<512>(int64_t val) : val{_mm512_mask_set1_epi64(_mm512_set1_epi64(-(val < 0)), 1, val)} {
+    }
+    inline bitword<512>(int val) : bitword<512>((int64_t)val) {
+    }
+
+    inline static bitword<512> tile8(uint8_t pattern) {
+        return {_mm512_set1_epi8(pattern)};
+    }
+
+    inline static bitword<512> tile16(uint16_t pattern) {
+        return {_mm512_set1_epi16(pattern)};
+    }
+
+    inline static bitword<512> tile32(uint32_t pattern) {
+        return {_mm512_set1_epi32(pattern)};
+    }
+
+    inline static bitword<512> tile64(uint64_t pattern) {
+        return {_mm512_set1_epi64(pattern)};
+    }
+
+    inline std::array<uint64_t, 8> to_u64_array() const {
+        std::array<uint64_t, 8> result;
+        _mm512_storeu_si512(result.data(), val);
+        return result;
+    }
+
+    inline operator bool() const {  // NOLINT(hicpp-explicit-conversions)
+        return _mm512_test_epi64_mask(val, val) != 0;
+    }
+    inline operator int() const {  // NOLINT(hicpp-explicit-conversions)
+        return (int64_t)*this;
+    }
+    inline operator uint64_t() const {  // NOLINT(hicpp-explicit-conversions)
+        auto words = to_u64_array();
+        for (size_t k = 1; k < 8; k++) {
+            if (words[k]) {
+                throw std::invalid_argument("Too large for uint64_t");
+            }
+        }
+        return words[0];
+    }
+    inline operator int64_t() const {  // NOLINT(hicpp-explicit-conversions)
+        auto words = to_u64_array();
+        int64_t result = (int64_t)words[0];
+        uint64_t expected = result < 0 ? (uint64_t)-1 : (uint64_t)0;
+        for (size_t k = 1; k < 8; k++) {
+            if (words[k] != expected) {
+                throw std::invalid_argument("Out of bounds of int64_t");
+            }
+        }
+        return result;
+    }
+
+    inline bitword<512> &operator^=(const bitword<512> &other) {
+        val = _mm512_xor_si512(val, other.val);
+        return *this;
+    }
+
+    inline bitword<512> &operator&=(const bitword<512> &other) {
+        val = _mm512_and_si512(val, other.val);
+        return *this;
+    }
+
+    inline bitword<512> &operator|=(const bitword<512> &other) {
+        val = _mm512_or_si512(val, other.val);
+        return *this;
+    }
+
+    inline bitword<512> operator^(const bitword<512> &other) const {
+        return {_mm512_xor_si512(val, other.val)};
+    }
+
+    inline bitword<512> operator&(const bitword<512> &other) const {
+        return {_mm512_and_si512(val, other.val)};
+    }
+
+    inline bitword<512> operator|(const bitword<512> &other) const {
+        return {_mm512_or_si512(val, other.val)};
+    }
+
+    inline bitword<512> andnot(const bitword<512> &other) const {
+        // The zero-masked form is used because GCC's unmasked one starts from an uninitialized register, which triggers
+        // -Wmaybe-uninitialized.
+        return {_mm512_maskz_andnot_epi64(0xFF, val, other.val)};
+    }
+
+    inline uint16_t popcount() const {
+#if __AVX512VPOPCNTDQ__
+        // Horizontal sum of the lane counts. Uses zero-masked extracts instead of _mm512_reduce_add_epi64 (and
+        // _mm512_castsi512_si256), because GCC implements those starting from an uninitialized register, which
+        // triggers -Wmaybe-uninitialized.
+        __m512i counts = _mm512_popcnt_epi64(val);
+        __m256i c4 = _mm256_add_epi64(
+            _mm512_maskz_extracti64x4_epi64(0xF, counts, 0), _mm512_maskz_extracti64x4_epi64(0xF, counts, 1));
+        __m128i c2 = _mm_add_epi64(_mm256_castsi256_si128(c4), _mm256_extracti128_si256(c4, 1));
+        return (uint16_t)(_mm_cvtsi128_si64(c2) + _mm_extract_epi64(c2, 1));
+#else
+        auto v = to_u64_array();
+        uint16_t result = 0;
+        for (size_t k = 0; k < 8; k++) {
+            result += (uint16_t)std::popcount(v[k]);
+        }
+        return result;
+#endif
+    }
+
+    inline bitword<512> shifted(int offset) const {
+        auto w = to_u64_array();
+        std::array<uint64_t, 8> result{};
+        int word_offset = offset >= 0 ? offset / 64 : -((-offset + 63) / 64);
+        int bit_offset = offset - word_offset * 64;
+        for (int k = 0; k < 8; k++) {
+            int src = k - word_offset;
+            if (src >= 0 && src < 8) {
+                result[k] |= w[src] << bit_offset;
+            }
+            if (bit_offset && src - 1 >= 0 && src - 1 < 8) {
+                result[k] |= w[src - 1] >> (64 - bit_offset);
+            }
+        }
+        return bitword<512>(result);
+    }
+
+    inline std::string str() const {
+        std::stringstream out;
+        out << *this;
+        return out.str();
+    }
+
+    inline bool operator==(const bitword<512> &other) const {
+        return _mm512_cmpneq_epi64_mask(val, other.val) == 0;
+    }
+    inline bool operator!=(const bitword<512> &other) const {
+        return !(*this == other);
+    }
+    inline bool operator==(int other) const {
+        return *this == (bitword<512>)other;
+    }
+    inline bool operator!=(int other) const {
+        return *this != (bitword<512>)other;
+    }
+    inline bool operator==(uint64_t other) const {
+        return *this == (bitword<512>)other;
+    }
+    inline bool operator!=(uint64_t other) const {
+        return *this != (bitword<512>)other;
+    }
+    inline bool operator==(int64_t other) const {
+        return *this == (bitword<512>)other;
+    }
+    inline bool operator!=(int64_t other) const {
+        return *this != (bitword<512>)other;
+    }
+
+    /// Exchanges the off-diagonal bit blocks of size `shift` between row pairs (k, k + shift).
+    ///
+    /// Each row pair is updated with two bitwise selects (ternary logic 0xCA computes `mask ? b : c`).
+    template <uint64_t shift>
+    static void inplace_transpose_block_pass(bitword<512> *data, size_t stride, __m512i mask) {
+        for (size_t k = 0; k < 512; k++) {
+            if (k & shift) {
+                continue;
+            }
+            __m512i &x = data[stride * k].val;
+            __m512i &y = data[stride * (k + shift)].val;
+            // The zero-masked shifts are used because GCC's unmasked ones start from an uninitialized register,
+            // which triggers -Wmaybe-uninitialized.
+            __m512i y_up = _mm512_maskz_slli_epi64(0xFF, y, shift);
+            __m512i x_down = _mm512_maskz_srli_epi64(0xFF, x, shift);
+            __m512i x2 = _mm512_ternarylogic_epi64(mask, x, y_up, 0xCA);
+            y = _mm512_ternarylogic_epi64(mask, x_down, y, 0xCA);
+            x = x2;
+        }
+    }
+
+    /// Exchanges the off-diagonal blocks of 64 bit lanes between row pairs (k, k + 64 * lanes).
+    ///
+    /// The row pairs are rearranged by a single two-source permute each, picking lanes out of both rows.
+    template <uint64_t shift>
+    static void inplace_transpose_lane_pass(bitword<512> *data, size_t stride, __m512i lo_index, __m512i hi_index) {
+        for (size_t k = 0; k < 512; k++) {
+            if (k & shift) {
+                continue;
+            }
+            __m512i &x = data[stride * k].val;
+            __m512i &y = data[stride * (k + shift)].val;
+            __m512i x2 = _mm512_permutex2var_epi64(x, lo_index, y);
+            y = _mm512_permutex2var_epi64(x, hi_index, y);
+            x = x2;
+        }
+    }
+
+    static void inplace_transpose_square(bitword<512> *data, size_t stride) {
+        inplace_transpose_block_pass<1>(data, stride, _mm512_set1_epi8(0x55));
+        inplace_transpose_block_pass<2>(data, stride, _mm512_set1_epi8(0x33));
+        inplace_transpose_block_pass<4>(data, stride, _mm512_set1_epi8(0xF));
+        inplace_transpose_block_pass<8>(data, stride, _mm512_set1_epi16(0xFF));
+        inplace_transpose_block_pass<16>(data, stride, _mm512_set1_epi32(0xFFFF));
+        inplace_transpose_block_pass<32>(data, stride, _mm512_set1_epi64(0xFFFFFFFF));
+        // Lane indices 0-7 refer to the first row of the pair, and 8-15 refer to the second row.
+        inplace_transpose_lane_pass<64>(
+            data, stride, _mm512_set_epi64(14, 6, 12, 4, 10, 2, 8, 0), _mm512_set_epi64(15, 7, 13, 5, 11, 3, 9, 1));
+        inplace_transpose_lane_pass<128>(
+            data, stride, _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0), _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2));
+        inplace_transpose_lane_pass<256>(
+            data, stride, _mm512_set_epi64(11, 10, 9, 8, 3, 2, 1, 0), _mm512_set_epi64(15, 14, 13, 12, 7, 6, 5, 4));
+    }
+};
+
+/// Fuses the three-way xor into a single ternary logic instruction (truth table 0x96 is a ^ b ^ c).
+inline bitword<512> xor3(const bitword<512> &a, const bitword<512> &b, const bitword<512> &c) {
+    return {_mm512_ternarylogic_epi64(a.val, b.val, c.val, 0x96)};
+}
+
+}  // namespace stim
+
+#endif
+#endif
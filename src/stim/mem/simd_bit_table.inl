@@ -56,16 +56,28 @@ simd_bit_table<W> simd_bit_table<W>::square_mat_mul(const simd_bit_table<W> &rhs
     assert(num_major_bits_padded() >= n && num_minor_bits_padded() >= n);
     assert(rhs.num_major_bits_padded() >= n && rhs.num_minor_bits_padded() >= n);
 
-    auto tmp = rhs.transposed();
-
+    // Method of Four Russians. Each result row is the xor of the rhs rows selected by the bits of the lhs row.
+    // The rhs rows are handled in groups of 8, with all 256 xor combinations of a group precomputed, so that each
+    // result row only needs one row xor per group instead of one per set bit.
     simd_bit_table<W> result(n, n);
-    for (size_t row = 0; row < n; row++) {
-        for (size_t col = 0; col < n; col++) {
-            bitword<W> acc{};
-            (*this)[row].for_each_word(tmp[col], [&](bitword<W> &w1, bitword<W> &w2) {
-                acc ^= w1 & w2;
-            });
-            result[row][col] = acc.popcount() & 1;
+    simd_bit_table<W> combos(256, n);
+    for (size_t base = 0; base < n; base += 8) {
+        size_t group_size = std::min<size_t>(8, n - base);
+        for (size_t k = 0; k < group_size; k++) {
+            size_t bit = size_t{1} << k;
+            combos[bit].truncated_overwrite_from(rhs[base + k], n);
+            for (size_t s = 1; s < bit; s++) {
+                combos[bit | s] = combos[bit];
+                combos[bit | s] ^= combos[s];
+            }
+        }
+
+        uint8_t mask = (uint8_t)((1 << group_size) - 1);
+        for (size_t row = 0; row < n; row++) {
+            uint8_t s = (*this)[row].u8[base >> 3] & mask;
+            if (s) {
+                result[row] ^= combos[s];
+            }
         }
     }
 
@@ -90,16 +102,6 @@ simd_bit_table<W> simd_bit_table<W>::inverse_assuming_lower_triangular(size_t n)
     return result;
 }
 
-template <size_t W>
-void exchange_low_indices(simd_bit_table<W> &table) {
-    for (size_t maj_high = 0; maj_high < table.num_simd_words_major; maj_high++) {
-        for (size_t min_high = 0; min_high < table.num_simd_words_minor; min_high++) {
-            size_t block_start = table.get_index_of_bitword(maj_high, 0, min_high);
-            bitword<W>::inplace_transpose_square(table.data.ptr_simd + block_start, table.num_simd_words_minor);
-        }
-    }
-}
-
 template <size_t W>
 void simd_bit_table<W>::destructive_resize(size_t new_min_bits_major, size_t new_min_bits_minor) {
     num_simd_words_minor = min_bits_to_num_simd_words<W>(new_min_bits_minor);
@@ -137,26 +139,97 @@ void simd_bit_table<W>::resize(size_t new_min_bits_major, size_t new_min_bits_mi
     *this = std::move(new_table);
 }
 
+/// Transposes the WxW blocks (i, j) and (j, i) of a square table and swaps them, for every i in
+/// [maj_start, maj_end) and j in [min_start, min_end).
+///
+/// The larger of the two ranges is recursively split in half, so that the blocks being worked on stay close together
+/// in memory at every scale. This is a cache-oblivious traversal: it makes good use of every level of the cache (and
+/// of the TLB) without having to know their sizes.
+template <size_t W>
+void transpose_and_swap_blocks_recursive(
+    simd_bit_table<W> &table, size_t maj_start, size_t maj_end, size_t min_start, size_t min_end) {
+    size_t maj_size = maj_end - maj_start;
+    size_t min_size = min_end - min_start;
+    if (maj_size > 1 && maj_size >= min_size) {
+        size_t maj_mid = maj_start + maj_size / 2;
+        transpose_and_swap_blocks_recursive(table, maj_start, maj_mid, min_start, min_end);
+        transpose_and_swap_blocks_recursive(table, maj_mid, maj_end, min_start, min_end);
+    } else if (min_size > 1) {
+        size_t min_mid = min_start + min_size / 2;
+        transpose_and_swap_blocks_recursive(table, maj_start, maj_end, min_start, min_mid);
+        transpose_and_swap_blocks_recursive(table, maj_start, maj_end, min_mid, min_end);
+    } else if (maj_size == 1 && min_size == 1) {
+        size_t stride = table.num_simd_words_minor;
+        bitword<W> *block1 = table.data.ptr_simd + table.get_index_of_bitword(maj_start, 0, min_start);
+        bitword<W> *block2 = table.data.ptr_simd + table.get_index_of_bitword(min_start, 0, maj_start);
+        bitword<W>::inplace_transpose_square(block1, stride);
+        bitword<W>::inplace_transpose_square(block2, stride);
+        for (size_t maj_low = 0; maj_low < W; maj_low++) {
+            std::swap(block1[maj_low * stride], block2[maj_low * stride]);
+        }
+    }
+}
+
+/// Transposes the square sub-table made up of the WxW blocks (i, j) for i, j in [start, end).
+///
+/// Recurses into the two diagonal quadrants, and handles the off-diagonal quadrants with
+/// transpose_and_swap_blocks_recursive.
+template <size_t W>
+void square_transpose_blocks_recursive(simd_bit_table<W> &table, size_t start, size_t end) {
+    if (end - start == 1) {
+        bitword<W>::inplace_transpose_square(
+            table.data.ptr_simd + table.get_index_of_bitword(start, 0, start), table.num_simd_words_minor);
+    } else if (end - start > 1) {
+        size_t mid = start + (end - start) / 2;
+        square_transpose_blocks_recursive(table, start, mid);
+        square_transpose_blocks_recursive(table, mid, end);
+        transpose_and_swap_blocks_recursive(table, start, mid, mid, end);
+    }
+}
+
+/// Copies the WxW blocks (i, j) of `in` to the mirrored position (j, i) of `out` and transposes them there, for every
+/// i in [maj_start, maj_end) and j in [min_start, min_end).
+///
+/// Uses the same cache-oblivious recursive splitting as transpose_and_swap_blocks_recursive.
+template <size_t W>
+void transpose_blocks_into_recursive(
+    const simd_bit_table<W> &in,
+    simd_bit_table<W> &out,
+    size_t maj_start,
+    size_t maj_end,
+    size_t min_start,
+    size_t min_end) {
+    size_t maj_size = maj_end - maj_start;
+    size_t min_size = min_end - min_start;
+    if (maj_size > 1 && maj_size >= min_size) {
+        size_t maj_mid = maj_start + maj_size / 2;
+        transpose_blocks_into_recursive(in, out, maj_start, maj_mid, min_start, min_end);
+        transpose_blocks_into_recursive(in, out, maj_mid, maj_end, min_start, min_end);
+    } else if (min_size > 1) {
+        size_t min_mid = min_start + min_size / 2;
+        transpose_blocks_into_recursive(in, out, maj_start, maj_end, min_start, min_mid);
+        transpose_blocks_into_recursive(in, out, maj_start, maj_end, min_mid, min_end);
+    } else if (maj_size == 1 && min_size == 1) {
+        const bitword<W> *src = in.data.ptr_simd + in.get_index_of_bitword(maj_start, 0, min_start);
+        bitword<W> *dst = out.data.ptr_simd + out.get_index_of_bitword(min_start, 0, maj_start);
+        for (size_t maj_low = 0; maj_low < W; maj_low++) {
+            dst[maj_low * out.num_simd_words_minor] = src[maj_low * in.num_simd_words_minor];
+        }
+        bitword<W>::inplace_transpose_square(dst, out.num_simd_words_minor);
+    }
+}
+
 template <size_t W>
 void simd_bit_table<W>::do_square_transpose() {
     assert(num_simd_words_minor == num_simd_words_major);
 
     // Current address tensor indices: [...min_low ...min_high ...maj_low ...maj_high]
 
-    exchange_low_indices(*this);
+    // Each WxW block is transposed and then immediately moved to its mirrored position, while it's still in cache.
+    // The blocks are visited in a cache-oblivious recursive order, so tables much larger than the cache don't pay for
+    // walking entire columns of blocks.
+    square_transpose_blocks_recursive(*this, 0, num_simd_words_major);
 
-    // Current address tensor indices: [...maj_low ...min_high ...min_low ...maj_high]
-
-    // Permute data such that high address bits of majors and minors are exchanged.
-    for (size_t maj_high = 0; maj_high < num_simd_words_major; maj_high++) {
-        for (size_t min_high = maj_high + 1; min_high < num_simd_words_minor; min_high++) {
-            for (size_t maj_low = 0; maj_low < W; maj_low++) {
-                std::swap(
-                    data.ptr_simd[get_index_of_bitword(maj_high, maj_low, min_high)],
-                    data.ptr_simd[get_index_of_bitword(min_high, maj_low, maj_high)]);
-            }
-        }
-    }
     // Current address tensor indices: [...maj_low ...maj_high ...min_low ...min_high]
 }
 
@@ -194,17 +267,10 @@ void simd_bit_table<W>::transpose_into(simd_bit_table<W> &out) const {
     assert(out.num_simd_words_minor == num_simd_words_major);
     assert(out.num_simd_words_major == num_simd_words_minor);
 
-    for (size_t maj_high = 0; maj_high < num_simd_words_major; maj_high++) {
-        for (size_t min_high = 0; min_high < num_simd_words_minor; min_high++) {
-            for (size_t maj_low = 0; maj_low < W; maj_low++) {
-                size_t src_index = get_index_of_bitword(maj_high, maj_low, min_high);
-                size_t dst_index = out.get_index_of_bitword(min_high, maj_low, maj_high);
-                out.data.ptr_simd[dst_index] = data.ptr_simd[src_index];
-            }
-        }
-    }
-
-    exchange_low_indices(out);
+    // Each WxW block is copied to its mirrored position and then transposed there while it's still in cache.
+    // The blocks are visited in a cache-oblivious recursive order, so tables much larger than the cache don't pay for
+    // walking entire columns of blocks.
+    transpose_blocks_into_recursive(*this, out, 0, num_simd_words_major, 0, num_simd_words_minor);
 }
 
 template <size_t W>
@@ -38,3 +38,36 @@ BENCHMARK(simd_bit_table_out_of_place_transpose_diam10K) {
         .goal_millis(12)
         .show_rate("Bits", n * n);
 }
+
+BENCHMARK(simd_bit_table_inplace_square_transpose_diam40K) {
+    size_t n = 40 * 1000;
+    simd_bit_table<MAX_BITWORD_WIDTH> table(n, n);
+    benchmark_go([&]() {
+        table.do_square_transpose();
+    })
+        .goal_millis(100)
+        .show_rate("Bits", n * n);
+}
+
+BENCHMARK(simd_bit_table_out_of_place_transpose_diam40K) {
+    size_t n = 40 * 1000;
+    simd_bit_table<MAX_BITWORD_WIDTH> table(n, n);
+    simd_bit_table<MAX_BITWORD_WIDTH> out(n, n);
+    benchmark_go([&]() {
+        table.transpose_into(out);
+    })
+        .goal_millis(200)
+        .show_rate("Bits", n * n);
+}
+
+BENCHMARK(simd_bit_table_out_of_place_transpose_10Kx100K) {
+    size_t n = 10 * 1000;
+    size_t m = 100 * 1000;
+    simd_bit_table<MAX_BITWORD_WIDTH> table(n, m);
+    simd_bit_table<MAX_BITWORD_WIDTH> out(m, n);
+    benchmark_go([&]() {
+        table.transpose_into(out);
+    })
+        .goal_millis(120)
+        .show_rate("Bits", n * m);
+}
@@ -70,7 +70,7 @@ TEST_EACH_WORD_SIZE_W(simd_bit_table, creation, {
         ".....");
 
     simd_bit_table<W> t = simd_bit_table<W>::from_text("", 512, 256);
-    ASSERT_EQ(t.num_minor_bits_padded(), 256);
+    ASSERT_EQ(t.num_minor_bits_padded(), std::max<size_t>(W, 256));
     ASSERT_EQ(t.num_major_bits_padded(), 512);
 })
 
@@ -112,6 +112,24 @@ TEST_EACH_WORD_SIZE_W(simd_bit_table, multiplication, {
         "...");
 })
 
+TEST_EACH_WORD_SIZE_W(simd_bit_table, multiplication_random, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    for (size_t n : std::vector<size_t>{1, 7, 8, 9, 63, 130}) {
+        auto m1 = simd_bit_table<W>::random(n, n, rng);
+        auto m2 = simd_bit_table<W>::random(n, n, rng);
+        auto m3 = m1.square_mat_mul(m2, n);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < n; c++) {
+                bool expected = false;
+                for (size_t k = 0; k < n; k++) {
+                    expected ^= m1[r][k] & m2[k][c];
+                }
+                ASSERT_EQ(m3[r][c], expected) << n << "," << r << "," << c;
+            }
+        }
+    }
+})
+
 TEST_EACH_WORD_SIZE_W(simd_bit_table, xor_row_into, {
     simd_bit_table<W> m(500, 500);
     m[0][10] = true;
@@ -199,6 +217,31 @@ TEST_EACH_WORD_SIZE_W(simd_bit_table, transposed, {
     ASSERT_EQ(trans2, m);
 })
 
+TEST_EACH_WORD_SIZE_W(simd_bit_table, transposed_multiple_blocks_vs_naive, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    size_t n = 3 * W + 5;
+    auto t = simd_bit_table<W>::random(n, n, rng);
+    simd_bit_table<W> expected(n, n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            expected[j][i] = t[i][j];
+        }
+    }
+
+    auto square = t;
+    square.do_square_transpose();
+    ASSERT_EQ(square, expected);
+    ASSERT_EQ(t.transposed(), expected);
+
+    auto wide = simd_bit_table<W>::random(W + 3, 4 * W, rng);
+    auto wide_t = wide.transposed();
+    for (size_t i = 0; i < W + 3; i++) {
+        for (size_t j = 0; j < 4 * W; j++) {
+            ASSERT_EQ(wide_t[j][i], wide[i][j]);
+        }
+    }
+})
+
 TEST_EACH_WORD_SIZE_W(simd_bit_table, random, {
     auto rng = INDEPENDENT_TEST_RNG();
     auto t = simd_bit_table<W>::random(100, 90, rng);
@@ -14,6 +14,7 @@
 
 #include "stim/mem/simd_bits.h"
 
+#include <algorithm>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -68,7 +69,17 @@ TEST_EACH_WORD_SIZE_W(simd_bits, aliased_editing_and_bit_refs, {
 
 TEST_EACH_WORD_SIZE_W(simd_bits, min_bits_to_num_bits_padded, {
     const auto &f = &min_bits_to_num_bits_padded<W>;
-    if (W == 256) {
+    if (W == 512) {
+        ASSERT_EQ(f(0), 0);
+        ASSERT_EQ(f(1), 512);
+        ASSERT_EQ(f(100), 512);
+        ASSERT_EQ(f(511), 512);
+        ASSERT_EQ(f(512), 512);
+        ASSERT_EQ(f(513), 1024);
+        ASSERT_EQ(f((1 << 30) - 1), 1 << 30);
+        ASSERT_EQ(f(1 << 30), 1 << 30);
+        ASSERT_EQ(f((1 << 30) + 1), (1 << 30) + 512);
+    } else if (W == 256) {
         ASSERT_EQ(f(0), 0);
         ASSERT_EQ(f(1), 256);
         ASSERT_EQ(f(100), 256);
@@ -105,19 +116,12 @@ TEST_EACH_WORD_SIZE_W(simd_bits, min_bits_to_num_bits_padded, {
 
 TEST_EACH_WORD_SIZE_W(simd_bits, str, {
     simd_bits<W> d(256);
-    ASSERT_EQ(
-        d.str(),
-        "________________________________________________________________"
-        "________________________________________________________________"
-        "________________________________________________________________"
-        "________________________________________________________________");
+    ASSERT_EQ(d.num_bits_padded(), std::max<size_t>(W, 256));
+    std::string expected(d.num_bits_padded(), '_');
+    ASSERT_EQ(d.str(), expected);
     d[5] = true;
-    ASSERT_EQ(
-        d.str(),
-        "_____1__________________________________________________________"
-        "________________________________________________________________"
-        "________________________________________________________________"
-        "________________________________________________________________");
+    expected[5] = '1';
+    ASSERT_EQ(d.str(), expected);
 })
 
 TEST_EACH_WORD_SIZE_W(simd_bits, randomize, {
@@ -237,8 +241,8 @@ TEST_EACH_WORD_SIZE_W(simd_bits, add_assignment, {
     m0 += m1;
     ASSERT_EQ(m0[0], 0);
     ASSERT_EQ(m0[64], 1);
-    // Test carrying across multiple (>=2) words.
-    size_t num_bits = 193;
+    // Test carrying across multiple (>=2) words, into the last padded word.
+    size_t num_bits = std::max<size_t>(W, 256) - 63;
     simd_bits<W> add(num_bits);
     simd_bits<W> one(num_bits);
     for (size_t word = 0; word < add.num_u64_padded() - 1; word++) {
@@ -578,7 +582,7 @@ TEST_EACH_WORD_SIZE_W(simd_bits, not_zero, {
 })
 
 TEST_EACH_WORD_SIZE_W(simd_bits, word_range_ref, {
-    simd_bits<W> d(1024);
+    simd_bits<W> d(std::max<size_t>(4 * W, 1024));
     const simd_bits<W> &cref = d;
     auto r1 = d.word_range_ref(1, 2);
     auto r2 = d.word_range_ref(2, 2);
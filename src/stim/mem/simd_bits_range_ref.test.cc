@@ -303,7 +303,7 @@ TEST_EACH_WORD_SIZE_W(simd_bits_range_ref, not_zero256, {
 })
 
 TEST_EACH_WORD_SIZE_W(simd_bits_range_ref, word_range_ref, {
-    bitword<W> d[sizeof(uint64_t) * 16 / sizeof(bitword<W>)]{};
+    bitword<W> d[std::max<size_t>(sizeof(uint64_t) * 16 / sizeof(bitword<W>), 4)]{};
     simd_bits_range_ref<W> ref(d, sizeof(d) / sizeof(bitword<W>));
     const simd_bits_range_ref<W> cref(d, sizeof(d) / sizeof(bitword<W>));
     auto r1 = ref.word_range_ref(1, 2);
@@ -403,7 +403,7 @@ TEST_EACH_WORD_SIZE_W(simd_bits_range_ref, prefix_ref, {
 })
 
 TEST_EACH_WORD_SIZE_W(simd_bits_range_ref, as_u64, {
-    simd_bits<W> data(1024);
+    simd_bits<W> data(std::max<size_t>(1024, 4 * W));
     simd_bits_range_ref<W> ref(data);
     ASSERT_EQ(data.as_u64(), 0);
     ASSERT_EQ(ref.as_u64(), 0);
@@ -358,6 +358,58 @@ TEST_EACH_WORD_SIZE_W(simd_util, inplace_transpose, {
                 6,
                 7,
             });
+    } else if (W == 512) {
+        EXPECT_FUNCTION_PERFORMS_ADDRESS_BIT_PERMUTATION<18, W>(
+            [](simd_bits<W> &d) {
+                bitword<W>::inplace_transpose_square(d.ptr_simd, 1);
+            },
+            {
+                9,
+                10,
+                11,
+                12,
+                13,
+                14,
+                15,
+                16,
+                17,
+                0,
+                1,
+                2,
+                3,
+                4,
+                5,
+                6,
+                7,
+                8,
+            });
+
+        EXPECT_FUNCTION_PERFORMS_ADDRESS_BIT_PERMUTATION<19, W>(
+            [](simd_bits<W> &d) {
+                bitword<W>::inplace_transpose_square(d.ptr_simd, 2);
+                bitword<W>::inplace_transpose_square(d.ptr_simd + 1, 2);
+            },
+            {
+                10,
+                11,
+                12,
+                13,
+                14,
+                15,
+                16,
+                17,
+                18,
+                9,
+                0,
+                1,
+                2,
+                3,
+                4,
+                5,
+                6,
+                7,
+                8,
+            });
     }
 })
 
@@ -159,3 +159,17 @@ TEST_EACH_WORD_SIZE_W(simd_word, from_u64_array, {
     std::array<uint64_t, W / 64> actual = w.to_u64_array();
     ASSERT_EQ(actual, expected);
 })
+
+TEST_EACH_WORD_SIZE_W(simd_word, xor3, {
+    std::array<uint64_t, W / 64> a;
+    std::array<uint64_t, W / 64> b;
+    std::array<uint64_t, W / 64> c;
+    std::array<uint64_t, W / 64> expected;
+    for (size_t k = 0; k < expected.size(); k++) {
+        a[k] = 0xFF00FF00FF00FF00ULL + k;
+        b[k] = 0xF0F0F0F0F0F0F0F0ULL * (k + 1);
+        c[k] = 0xCCCCCCCCCCCCCCCCULL ^ (k << 7);
+        expected[k] = a[k] ^ b[k] ^ c[k];
+    }
+    ASSERT_EQ(xor3(simd_word<W>(a), simd_word<W>(b), simd_word<W>(c)), simd_word<W>(expected));
+})
@@ -18,6 +18,24 @@
         __VA_ARGS__                                               \
     }
 
+#define TEST_EACH_WORD_SIZE_UP_TO_512(test_suite, test_name, ...) \
+    TEST(test_suite, test_name##_512) {                           \
+        constexpr size_t W = 512;                                 \
+        __VA_ARGS__                                               \
+    }                                                             \
+    TEST(test_suite, test_name##_256) {                           \
+        constexpr size_t W = 256;                                 \
+        __VA_ARGS__                                               \
+    }                                                             \
+    TEST(test_suite, test_name##_128) {                           \
+        constexpr size_t W = 128;                                 \
+        __VA_ARGS__                                               \
+    }                                                             \
+    TEST(test_suite, test_name##_64) {                            \
+        constexpr size_t W = 64;                                  \
+        __VA_ARGS__                                               \
+    }
+
 #define TEST_EACH_WORD_SIZE_UP_TO_256(test_suite, test_name, ...) \
     TEST(test_suite, test_name##_256) {                           \
         constexpr size_t W = 256;                                 \
@@ -32,7 +50,10 @@
         __VA_ARGS__                                               \
     }
 
-#if __AVX2__
+#if __AVX512F__
+#define TEST_EACH_WORD_SIZE_W(test_suite, test_name, ...) \
+    TEST_EACH_WORD_SIZE_UP_TO_512(test_suite, test_name, __VA_ARGS__)
+#elif __AVX2__
 #define TEST_EACH_WORD_SIZE_W(test_suite, test_name, ...) \
     TEST_EACH_WORD_SIZE_UP_TO_256(test_suite, test_name, __VA_ARGS__)
 #elif __SSE2__
@@ -366,14 +366,14 @@ void stim_pybind::pybind_compiled_detector_sampler_methods(
         pybind11::arg("obs_out_filepath") = pybind11::none(),
         pybind11::arg("obs_out_format") = "01",
         clean_doc_string(R"DOC(
-            @signature def sample_write(self, shots: int, *, filepath: Union[str, pathlib.Path], format: 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]' = '01', obs_out_filepath: Optional[Union[str, pathlib.Path]] = None, obs_out_format: 'Literal["01", "b8", "r8", "ptb64", "hits", "dets"]' = '01', prepend_observables: bool = False, append_observables: bool = False) -> None:
+            @signature def sample_write(self, shots: int, *, filepath: Union[str, pathlib.Path], format: 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]' = '01', obs_out_filepath: Optional[Union[str, pathlib.Path]] = None, obs_out_format: 'Literal["01", "b8", "r8", "rice", "ptb64", "hits", "dets"]' = '01', prepend_observables: bool = False, append_observables: bool = False) -> None:
             Samples detection events from the circuit and writes them to a file.
 
             Args:
                 shots: The number of times to sample every measurement in the circuit.
                 filepath: The file to write the results to.
                 format: The output format to write the results with.
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
                 obs_out_filepath: Sample observables as part of each shot, and write them to
                     this file. This keeps the observable data separate from the detector
@@ -381,7 +381,7 @@ void stim_pybind::pybind_compiled_detector_sampler_methods(
                 obs_out_format: If writing the observables to a file, this is the format to
                     write them in.
 
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
                 prepend_observables: Sample observables as part of each shot, and put them
                     at the start of the detector data.
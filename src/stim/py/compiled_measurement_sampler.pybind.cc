@@ -19,6 +19,7 @@
 #include "stim/py/numpy.pybind.h"
 #include "stim/simulators/frame_simulator_util.h"
 #include "stim/simulators/tableau_simulator.h"
+#include "stim/util_top/reference_sample_tree.h"
 
 using namespace stim;
 using namespace stim_pybind;
@@ -68,7 +69,7 @@ CompiledMeasurementSampler stim_pybind::py_init_compiled_sampler(
     if (reference_sample.is_none()) {
         simd_bits<MAX_BITWORD_WIDTH> ref_sample =
             skip_reference_sample ? simd_bits<MAX_BITWORD_WIDTH>(circuit.count_measurements())
-                                  : TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(circuit);
+                                  : reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit);
         return CompiledMeasurementSampler(ref_sample, circuit, skip_reference_sample, make_py_seeded_rng(seed));
     } else {
         if (skip_reference_sample) {
@@ -273,7 +274,7 @@ void stim_pybind::pybind_compiled_measurement_sampler_methods(
                 shots: The number of times to sample every measurement in the circuit.
                 filepath: The file to write the results to.
                 format: The output format to write the results with.
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
 
             Returns:
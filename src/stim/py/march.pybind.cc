@@ -4,8 +4,12 @@
 
 #ifdef _WIN32
 //  Windows
+#include <immintrin.h>
 #include <intrin.h>
 #define cpuid(info, x) __cpuidex(info, x, 0)
+uint64_t xgetbv(uint32_t index) {
+    return _xgetbv(index);
+}
 #elif (defined(__arm64__) && defined(__APPLE__)) || defined(__aarch64__) || defined(_ARCH_PPC)
 // macOS ARM64 and IBM PowerPC (dummied out)
 void cpuid(int info[4], int infoType) {
@@ -14,30 +18,53 @@ void cpuid(int info[4], int infoType) {
     info[2] = 0;
     info[3] = 0;
 }
+uint64_t xgetbv(uint32_t index) {
+    return 0;
+}
 #else
 //  GCC Intrinsics
-//#include <cpuid.h>
-/*void cpuid(int info[4], int infoType) {
+#include <cpuid.h>
+void cpuid(int info[4], int infoType) {
     __cpuid_count(infoType, 0, info[0], info[1], info[2], info[3]);
-}*/
+}
+uint64_t xgetbv(uint32_t index) {
+    uint32_t eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+    return ((uint64_t)edx << 32) | eax;
+}
 #endif
 
 std::string detect_march() {
     // From: https://en.wikipedia.org/wiki/CPUID
     constexpr int EAX = 0;
     constexpr int EBX = 1;
+    constexpr int ECX = 2;
     constexpr int EDX = 3;
     constexpr int INFO_HIGHEST_FUNCTION_PARAMETER = 0;
     constexpr int INFO_PROCESSOR_FEATURE_BITS = 1;
     constexpr int INFO_EXTENDED_FEATURES = 7;
+    constexpr int osxsave_bit_in_ecx = 1 << 27;
+    constexpr int avx512f_bit_in_ebx = 1 << 16;
     constexpr int avx2_bit_in_ebx = 1 << 5;
     constexpr int sse2_bit_in_edx = 1 << 26;
+    // The OS must save the SSE, AVX, opmask, and upper ZMM register state (XCR0 bits 1, 2, 5, 6, 7).
+    constexpr uint64_t avx512_os_state_bits = 0xE6;
 
-    /*int regs[4];
+    int regs[4];
     cpuid(regs, INFO_HIGHEST_FUNCTION_PARAMETER);
     auto max_info_param = regs[EAX];
 
     if (max_info_param >= INFO_EXTENDED_FEATURES) {
+        cpuid(regs, INFO_PROCESSOR_FEATURE_BITS);
+        bool os_saves_state = (regs[ECX] & osxsave_bit_in_ecx) != 0;
+        cpuid(regs, INFO_EXTENDED_FEATURES);
+        if (os_saves_state && (regs[EBX] & avx512f_bit_in_ebx) &&
+            (xgetbv(0) & avx512_os_state_bits) == avx512_os_state_bits) {
+            return "avx512";
+        }
+    }
+
+    /*if (max_info_param >= INFO_EXTENDED_FEATURES) {
         cpuid(regs, INFO_EXTENDED_FEATURES);
         if (regs[EBX] & avx2_bit_in_ebx) {
             return "avx2";
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 
+#include "stim/io/background_writer.h"
 #include "stim/io/measure_record_reader.h"
 #include "stim/io/measure_record_writer.h"
 #include "stim/simulators/dem_sampler.h"
@@ -82,6 +83,13 @@ void DemSampler<W>::sample_write(
     SampleFormat err_out_format,
     FILE *err_in,
     SampleFormat err_in_format) {
+    // Each batch is written by a background thread while the next batch is sampled. The background thread owns
+    // the 'back' buffers, which are swapped with the sampler's buffers.
+    simd_bit_table<W> back_det_buffer = det_buffer;
+    simd_bit_table<W> back_obs_buffer = obs_buffer;
+    simd_bit_table<W> back_err_buffer = err_buffer;
+    BackgroundWriter background_writer;
+
     for (size_t k = 0; k < num_shots; k += num_stripes) {
         size_t shots_left = std::min(num_stripes, num_shots - k);
 
@@ -94,37 +102,52 @@ void DemSampler<W>::sample_write(
         }
         resample(err_in != nullptr);
 
-        if (err_out != nullptr) {
-            write_table_data(
-                err_out, shots_left, (size_t)num_errors, simd_bits<W>(0), err_buffer, err_out_format, 'M', 'M', false);
-        }
+        background_writer.wait();
+        std::swap(back_det_buffer, det_buffer);
+        std::swap(back_obs_buffer, obs_buffer);
+        std::swap(back_err_buffer, err_buffer);
+        background_writer.start([=, this, &back_det_buffer, &back_obs_buffer, &back_err_buffer]() {
+            if (err_out != nullptr) {
+                write_table_data(
+                    err_out,
+                    shots_left,
+                    (size_t)num_errors,
+                    simd_bits<W>(0),
+                    back_err_buffer,
+                    err_out_format,
+                    'M',
+                    'M',
+                    false);
+            }
 
-        if (obs_out != nullptr) {
-            write_table_data(
-                obs_out,
-                shots_left,
-                (size_t)num_observables,
-                simd_bits<W>(0),
-                obs_buffer,
-                obs_out_format,
-                'L',
-                'L',
-                false);
-        }
+            if (obs_out != nullptr) {
+                write_table_data(
+                    obs_out,
+                    shots_left,
+                    (size_t)num_observables,
+                    simd_bits<W>(0),
+                    back_obs_buffer,
+                    obs_out_format,
+                    'L',
+                    'L',
+                    false);
+            }
 
-        if (det_out != nullptr) {
-            write_table_data(
-                det_out,
-                shots_left,
-                (size_t)num_detectors,
-                simd_bits<W>(0),
-                det_buffer,
-                det_out_format,
-                'D',
-                'D',
-                false);
-        }
+            if (det_out != nullptr) {
+                write_table_data(
+                    det_out,
+                    shots_left,
+                    (size_t)num_detectors,
+                    simd_bits<W>(0),
+                    back_det_buffer,
+                    det_out_format,
+                    'D',
+                    'D',
+                    false);
+            }
+        });
     }
+    background_writer.wait();
 }
 
 }  // namespace stim
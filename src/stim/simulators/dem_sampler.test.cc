@@ -98,3 +98,43 @@ TEST_EACH_WORD_SIZE_W(DemSampler, resample_combinations, {
         ASSERT_FALSE(total.not_zero());
     }
 })
+
+TEST_EACH_WORD_SIZE_W(DemSampler, sample_write_many_batches, {
+    DemSampler<W> sampler(
+        DetectorErrorModel(R"DEM(
+            error(0.5) D0 L0
+            error(0) D1
+            error(1) D2
+         )DEM"),
+        INDEPENDENT_TEST_RNG(),
+        64);
+    FILE *det_out = tmpfile();
+    FILE *obs_out = tmpfile();
+    FILE *err_out = tmpfile();
+    sampler.sample_write(
+        1000,
+        det_out,
+        SampleFormat::SAMPLE_FORMAT_01,
+        obs_out,
+        SampleFormat::SAMPLE_FORMAT_01,
+        err_out,
+        SampleFormat::SAMPLE_FORMAT_01,
+        nullptr,
+        SampleFormat::SAMPLE_FORMAT_01);
+    std::string dets = rewind_read_close(det_out);
+    std::string obs = rewind_read_close(obs_out);
+    std::string errs = rewind_read_close(err_out);
+    ASSERT_EQ(dets.size(), 1000 * 4);
+    ASSERT_EQ(obs.size(), 1000 * 2);
+    ASSERT_EQ(errs.size(), 1000 * 4);
+    size_t num_hits = 0;
+    for (size_t k = 0; k < 1000; k++) {
+        ASSERT_EQ(dets.substr(k * 4 + 1, 3), "01\n");
+        ASSERT_EQ(errs.substr(k * 4 + 1, 3), "01\n");
+        ASSERT_EQ(dets[k * 4], errs[k * 4]);
+        ASSERT_EQ(dets[k * 4], obs[k * 2]);
+        num_hits += dets[k * 4] == '1';
+    }
+    ASSERT_GT(num_hits, 300);
+    ASSERT_LT(num_hits, 700);
+})
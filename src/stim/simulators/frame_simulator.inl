@@ -403,7 +403,7 @@ void FrameSimulator<W>::single_cy(uint32_t c, uint32_t t) {
             x_table[t],
             z_table[t],
             [](simd_word<W> &x1, simd_word<W> &z1, simd_word<W> &x2, simd_word<W> &z2) {
-                z1 ^= x2 ^ z2;
+                z1 = xor3(z1, x2, z2);
                 z2 ^= x1;
                 x2 ^= x1;
             });
@@ -540,7 +540,7 @@ template <size_t W>
 void FrameSimulator<W>::do_SQRT_YY(const CircuitInstruction &target_data) {
     for_each_target_pair(
         *this, target_data, [](simd_word<W> &x1, simd_word<W> &z1, simd_word<W> &x2, simd_word<W> &z2) {
-            auto d = x1 ^ z1 ^ x2 ^ z2;
+            auto d = xor3(x1, z1, x2) ^ z2;
             x1 ^= d;
             z1 ^= d;
             x2 ^= d;
@@ -571,7 +571,7 @@ template <size_t W>
 void FrameSimulator<W>::do_XCY(const CircuitInstruction &target_data) {
     for_each_target_pair(
         *this, target_data, [](simd_word<W> &x1, simd_word<W> &z1, simd_word<W> &x2, simd_word<W> &z2) {
-            x1 ^= x2 ^ z2;
+            x1 = xor3(x1, x2, z2);
             x2 ^= z1;
             z2 ^= z1;
         });
@@ -590,7 +590,7 @@ template <size_t W>
 void FrameSimulator<W>::do_YCX(const CircuitInstruction &target_data) {
     for_each_target_pair(
         *this, target_data, [](simd_word<W> &x1, simd_word<W> &z1, simd_word<W> &x2, simd_word<W> &z2) {
-            x2 ^= x1 ^ z1;
+            x2 = xor3(x2, x1, z1);
             x1 ^= z2;
             z1 ^= z2;
         });
@@ -858,6 +858,34 @@ TEST_EACH_WORD_SIZE_W(FrameSimulator, stream_huge_case, {
     ASSERT_EQ(getc(tmp), EOF);
 })
 
+TEST_EACH_WORD_SIZE_W(FrameSimulator, stream_many_batches, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    DebugForceResultStreamingRaii force_streaming;
+    FILE *tmp = tmpfile();
+    sample_batch_measurements_writing_results_to_disk(
+        Circuit(R"CIRCUIT(
+            X_ERROR(1) 1
+            REPEAT 100 {
+                M 0 1 2
+            }
+        )CIRCUIT"),
+        simd_bits<W>(0),
+        3 * W + 5,
+        tmp,
+        SampleFormat::SAMPLE_FORMAT_01,
+        rng);
+    rewind(tmp);
+    for (size_t s = 0; s < 3 * W + 5; s++) {
+        for (size_t k = 0; k < 100; k++) {
+            ASSERT_EQ(getc(tmp), '0');
+            ASSERT_EQ(getc(tmp), '1');
+            ASSERT_EQ(getc(tmp), '0');
+        }
+        ASSERT_EQ(getc(tmp), '\n');
+    }
+    ASSERT_EQ(getc(tmp), EOF);
+})
+
 TEST_EACH_WORD_SIZE_W(FrameSimulator, block_results_single_shot, {
     auto rng = INDEPENDENT_TEST_RNG();
     auto circuit = Circuit(R"circuit(
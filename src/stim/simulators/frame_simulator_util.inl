@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+
+#include "stim/io/background_writer.h"
 #include "stim/simulators/force_streaming.h"
 #include "stim/simulators/frame_simulator.h"
 #include "stim/simulators/frame_simulator_util.h"
@@ -34,11 +37,24 @@ std::pair<simd_bit_table<W>, simd_bit_table<W>> sample_batch_detection_events(
     };
 }
 
+/// Creates a batch writer whose output is deferred until `write_end`, so it can be finished by a background writer.
+///
+/// Each batch writer holds a temporary file per shot. When two writers' worth of files would exceed the safety limit,
+/// the previous batch is finished before the files for the next batch are created.
+inline std::shared_ptr<MeasureRecordBatchWriter> make_deferred_batch_writer(
+    FILE *out, size_t num_shots, SampleFormat format, BackgroundWriter &background_writer) {
+    if (2 * num_shots > MeasureRecordBatchWriter::MAX_SHOTS) {
+        background_writer.wait();
+    }
+    return std::make_shared<MeasureRecordBatchWriter>(out, num_shots, format, true);
+}
+
 template <size_t W>
 void rerun_frame_sim_while_streaming_dets_to_disk(
     const Circuit &circuit,
     CircuitStats circuit_stats,
     FrameSimulator<W> &sim,
+    BackgroundWriter &background_writer,
     size_t num_shots,
     bool prepend_observables,
     bool append_observables,
@@ -52,10 +68,9 @@ void rerun_frame_sim_while_streaming_dets_to_disk(
             "results");
     }
 
-    MeasureRecordBatchWriter writer(out, num_shots, format);
-    std::vector<simd_bits<W>> observables;
+    auto writer = make_deferred_batch_writer(out, num_shots, format, background_writer);
     sim.reset_all();
-    writer.begin_result_type('D');
+    writer->begin_result_type('D');
     circuit.for_each_operation([&](const CircuitInstruction &op) {
         sim.do_gate(op);
         sim.m_record.mark_all_as_written();
@@ -64,58 +79,71 @@ void rerun_frame_sim_while_streaming_dets_to_disk(
             if (sim.det_record.unwritten >= WRITE_SIZE) {
                 assert(sim.det_record.stored == WRITE_SIZE);
                 assert(sim.det_record.unwritten == WRITE_SIZE);
-                writer.batch_write_bytes<W>(sim.det_record.storage, WRITE_SIZE >> 6);
+                writer->batch_write_bytes<W>(sim.det_record.storage, WRITE_SIZE >> 6);
                 sim.det_record.clear();
             }
         }
     });
     for (size_t k = sim.det_record.stored - sim.det_record.unwritten; k < sim.det_record.stored; k++) {
-        writer.batch_write_bit<W>(sim.det_record.storage[k]);
+        writer->batch_write_bit<W>(sim.det_record.storage[k]);
     }
     if (append_observables) {
-        writer.begin_result_type('L');
+        writer->begin_result_type('L');
         for (size_t k = 0; k < circuit_stats.num_observables; k++) {
-            writer.batch_write_bit<W>(sim.obs_record[k]);
+            writer->batch_write_bit<W>(sim.obs_record[k]);
         }
     }
-    writer.write_end();
 
+    // Concatenate the batch's temporary files onto the output while the next batch is simulated.
+    simd_bit_table<W> obs_data(0, 0);
     if (obs_out != nullptr) {
-        write_table_data(
-            obs_out,
-            num_shots,
-            circuit_stats.num_observables,
-            simd_bits<W>(0),
-            sim.obs_record,
-            obs_out_format,
-            'L',
-            'L',
-            circuit_stats.num_observables);
+        obs_data = sim.obs_record;
     }
+    background_writer.start([=]() {
+        writer->write_end();
+        if (obs_out != nullptr) {
+            write_table_data(
+                obs_out,
+                num_shots,
+                circuit_stats.num_observables,
+                simd_bits<W>(0),
+                obs_data,
+                obs_out_format,
+                'L',
+                'L',
+                circuit_stats.num_observables);
+        }
+    });
 }
 
 template <size_t W>
 void rerun_frame_sim_while_streaming_measurements_to_disk(
     const Circuit &circuit,
     FrameSimulator<W> &sim,
+    BackgroundWriter &background_writer,
     const simd_bits<W> &reference_sample,
     size_t num_shots,
     FILE *out,
     SampleFormat format) {
-    MeasureRecordBatchWriter writer(out, num_shots, format);
+    auto writer = make_deferred_batch_writer(out, num_shots, format, background_writer);
     sim.reset_all();
     circuit.for_each_operation([&](const CircuitInstruction &op) {
         sim.do_gate(op);
-        sim.m_record.intermediate_write_unwritten_results_to(writer, reference_sample);
+        sim.m_record.intermediate_write_unwritten_results_to(*writer, reference_sample);
+    });
+    sim.m_record.flush_unwritten_results_to(*writer, reference_sample);
+
+    // Concatenate the batch's temporary files onto the output while the next batch is simulated.
+    background_writer.start([=]() {
+        writer->write_end();
     });
-    sim.m_record.final_write_unwritten_results_to(writer, reference_sample);
 }
 
 template <size_t W>
-void rerun_frame_sim_in_memory_and_write_dets_to_disk(
-    const Circuit &circuit,
+void write_dets_to_disk(
     const CircuitStats &circuit_stats,
-    FrameSimulator<W> &frame_sim,
+    const simd_bit_table<W> &det_data,
+    const simd_bit_table<W> &obs_data,
     simd_bit_table<W> &out_concat_buf,
     size_t num_shots,
     bool prepend_observables,
@@ -124,22 +152,13 @@ void rerun_frame_sim_in_memory_and_write_dets_to_disk(
     SampleFormat format,
     FILE *obs_out,
     SampleFormat obs_out_format) {
-    if (prepend_observables + append_observables + (obs_out != nullptr) > 1) {
-        throw std::out_of_range("Can't combine --prepend_observables, --append_observables, or --obs_out");
-    }
-
-    frame_sim.reset_all();
-    frame_sim.do_circuit(circuit);
-
-    const auto &obs_data = frame_sim.obs_record;
-    const auto &det_data = frame_sim.det_record.storage;
     if (obs_out != nullptr) {
         write_table_data(
             obs_out,
             num_shots,
             circuit_stats.num_observables,
             simd_bits<W>(0),
-            frame_sim.obs_record,
+            obs_data,
             obs_out_format,
             'L',
             'L',
@@ -186,21 +205,66 @@ void rerun_frame_sim_in_memory_and_write_dets_to_disk(
     }
 }
 
+template <size_t W>
+void rerun_frame_sim_in_memory_and_write_dets_to_disk(
+    const Circuit &circuit,
+    const CircuitStats &circuit_stats,
+    FrameSimulator<W> &frame_sim,
+    simd_bit_table<W> &back_det_buf,
+    simd_bit_table<W> &back_obs_buf,
+    simd_bit_table<W> &out_concat_buf,
+    BackgroundWriter &background_writer,
+    size_t num_shots,
+    bool prepend_observables,
+    bool append_observables,
+    FILE *out,
+    SampleFormat format,
+    FILE *obs_out,
+    SampleFormat obs_out_format) {
+    frame_sim.reset_all();
+    frame_sim.do_circuit(circuit);
+
+    // Hand the results to the background writer, and take its previous buffers for the next batch.
+    background_writer.wait();
+    std::swap(back_det_buf, frame_sim.det_record.storage);
+    std::swap(back_obs_buf, frame_sim.obs_record);
+    background_writer.start([=, &circuit_stats, &back_det_buf, &back_obs_buf, &out_concat_buf]() {
+        write_dets_to_disk(
+            circuit_stats,
+            back_det_buf,
+            back_obs_buf,
+            out_concat_buf,
+            num_shots,
+            prepend_observables,
+            append_observables,
+            out,
+            format,
+            obs_out,
+            obs_out_format);
+    });
+}
+
 template <size_t W>
 void rerun_frame_sim_in_memory_and_write_measurements_to_disk(
     const Circuit &circuit,
-    CircuitStats circuit_stats,
+    const CircuitStats &circuit_stats,
     FrameSimulator<W> &frame_sim,
+    simd_bit_table<W> &back_measure_buf,
+    BackgroundWriter &background_writer,
     const simd_bits<W> &reference_sample,
     size_t num_shots,
     FILE *out,
     SampleFormat format) {
     frame_sim.reset_all();
     frame_sim.do_circuit(circuit);
-    const auto &measure_data = frame_sim.m_record.storage;
 
-    write_table_data(
-        out, num_shots, circuit_stats.num_measurements, reference_sample, measure_data, format, 'M', 'M', 0);
+    // Hand the results to the background writer, and take its previous buffer for the next batch.
+    background_writer.wait();
+    std::swap(back_measure_buf, frame_sim.m_record.storage);
+    background_writer.start([=, &circuit_stats, &back_measure_buf, &reference_sample]() {
+        write_table_data(
+            out, num_shots, circuit_stats.num_measurements, reference_sample, back_measure_buf, format, 'M', 'M', 0);
+    });
 }
 
 template <size_t W>
@@ -226,8 +290,12 @@ void sample_batch_detection_events_writing_results_to_disk(
     while (batch_size < 1024 && batch_size < num_shots) {
         batch_size += W;
     }
+    // The detection event and observable buffers are doubled, because the background writer holds the previous batch.
     uint64_t memory_per_full_shot =
-        2 * stats.num_qubits + 2 * stats.max_lookback + stats.num_observables + stats.num_detectors;
+        2 * stats.num_qubits + 2 * stats.max_lookback + 2 * (stats.num_observables + stats.num_detectors);
+    if (append_observables || prepend_observables) {
+        memory_per_full_shot += stats.num_observables + stats.num_detectors;
+    }
     while (batch_size > 0 &&
            should_use_streaming_because_bit_count_is_too_large_to_store(memory_per_full_shot * batch_size)) {
         batch_size -= W;
@@ -246,11 +314,25 @@ void sample_batch_detection_events_writing_results_to_disk(
         batch_size,
         std::move(rng));  // Will copy rng state back out later.
 
+    if (!streaming && prepend_observables + append_observables + (obs_out != nullptr) > 1) {
+        throw std::out_of_range("Can't combine --prepend_observables, --append_observables, or --obs_out");
+    }
+
     // Run the frame simulator until as many shots as requested have been written.
+    // Each batch is written by a background thread while the next batch is simulated. When storing results in memory,
+    // the background thread owns the 'back' buffers, which are swapped with the simulator's buffers. When streaming,
+    // the background thread concatenates the batch's temporary files onto the output.
     simd_bit_table<W> out_concat_buf(0, 0);
     if (append_observables || prepend_observables) {
         out_concat_buf = simd_bit_table<W>(stats.num_detectors + stats.num_observables, batch_size);
     }
+    simd_bit_table<W> back_det_buf(0, 0);
+    simd_bit_table<W> back_obs_buf(0, 0);
+    if (!streaming) {
+        back_det_buf = frame_sim.det_record.storage;
+        back_obs_buf = frame_sim.obs_record;
+    }
+    BackgroundWriter background_writer;
     size_t shots_left = num_shots;
     while (shots_left) {
         size_t shots_performed = std::min(shots_left, batch_size);
@@ -259,6 +341,7 @@ void sample_batch_detection_events_writing_results_to_disk(
                 circuit,
                 stats,
                 frame_sim,
+                background_writer,
                 shots_performed,
                 prepend_observables,
                 append_observables,
@@ -271,7 +354,10 @@ void sample_batch_detection_events_writing_results_to_disk(
                 circuit,
                 stats,
                 frame_sim,
+                back_det_buf,
+                back_obs_buf,
                 out_concat_buf,
+                background_writer,
                 shots_performed,
                 prepend_observables,
                 append_observables,
@@ -282,6 +368,7 @@ void sample_batch_detection_events_writing_results_to_disk(
         }
         shots_left -= shots_performed;
     }
+    background_writer.wait();
 
     // Update input rng as if it was used directly, by moving the updated state out of the simulator.
     rng = std::move(frame_sim.rng);
@@ -334,7 +421,8 @@ void sample_batch_measurements_writing_results_to_disk(
     while (batch_size < 1024 && batch_size < num_shots) {
         batch_size += W;
     }
-    uint64_t memory_per_full_shot = 2 * stats.num_qubits + stats.num_measurements;
+    // The measurement buffer is doubled, because the background writer holds the previous batch.
+    uint64_t memory_per_full_shot = 2 * stats.num_qubits + 2 * stats.num_measurements;
     while (batch_size > 0 &&
            should_use_streaming_because_bit_count_is_too_large_to_store(memory_per_full_shot * batch_size)) {
         batch_size -= W;
@@ -354,18 +442,35 @@ void sample_batch_measurements_writing_results_to_disk(
         std::move(rng));  // Temporarily move rng into simulator.
 
     // Run the frame simulator until as many shots as requested have been written.
+    // Each batch is written by a background thread while the next batch is simulated. When storing results in memory,
+    // the background thread owns the 'back' buffer, which is swapped with the simulator's buffer. When streaming, the
+    // background thread concatenates the batch's temporary files onto the output.
+    simd_bit_table<W> back_measure_buf(0, 0);
+    if (!streaming) {
+        back_measure_buf = frame_sim.m_record.storage;
+    }
+    BackgroundWriter background_writer;
     size_t shots_left = num_shots;
     while (shots_left) {
         size_t shots_performed = std::min(shots_left, batch_size);
         if (streaming) {
             rerun_frame_sim_while_streaming_measurements_to_disk(
-                circuit, frame_sim, reference_sample, shots_performed, out, format);
+                circuit, frame_sim, background_writer, reference_sample, shots_performed, out, format);
         } else {
             rerun_frame_sim_in_memory_and_write_measurements_to_disk(
-                circuit, stats, frame_sim, reference_sample, shots_performed, out, format);
+                circuit,
+                stats,
+                frame_sim,
+                back_measure_buf,
+                background_writer,
+                reference_sample,
+                shots_performed,
+                out,
+                format);
         }
         shots_left -= shots_performed;
     }
+    background_writer.wait();
 
     // Update input rng as if it was used directly, by moving the updated state out of the simulator.
     rng = std::move(frame_sim.rng);
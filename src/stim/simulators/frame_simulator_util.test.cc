@@ -78,6 +78,55 @@ TEST_EACH_WORD_SIZE_W(DetectionSimulator, sample_batch_detection_events_writing_
     ASSERT_EQ(rewind_read_close(tmp), "1,6\n1,6\n");
 })
 
+TEST_EACH_WORD_SIZE_W(DetectionSimulator, many_batches_in_memory, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    auto circuit = Circuit(R"circuit(
+        X_ERROR(1) 1
+        M 0 1
+        DETECTOR rec[-1]
+        DETECTOR rec[-2]
+        OBSERVABLE_INCLUDE(0) rec[-1]
+    )circuit");
+
+    // Several batches are written, overlapping with simulation of the following batch.
+    FILE *tmp = tmpfile();
+    sample_batch_detection_events_writing_results_to_disk<W>(
+        circuit, 3001, false, true, tmp, SampleFormat::SAMPLE_FORMAT_01, rng, nullptr, SampleFormat::SAMPLE_FORMAT_01);
+    std::string expected;
+    for (size_t k = 0; k < 3001; k++) {
+        expected += "101\n";
+    }
+    ASSERT_EQ(rewind_read_close(tmp), expected);
+
+    tmp = tmpfile();
+    FILE *obs_tmp = tmpfile();
+    sample_batch_detection_events_writing_results_to_disk<W>(
+        circuit, 3001, false, false, tmp, SampleFormat::SAMPLE_FORMAT_B8, rng, obs_tmp, SampleFormat::SAMPLE_FORMAT_01);
+    ASSERT_EQ(rewind_read_close(tmp), std::string(3001, '\x01'));
+    std::string expected_obs;
+    for (size_t k = 0; k < 3001; k++) {
+        expected_obs += "1\n";
+    }
+    ASSERT_EQ(rewind_read_close(obs_tmp), expected_obs);
+
+    tmp = tmpfile();
+    ASSERT_THROW(
+        {
+            sample_batch_detection_events_writing_results_to_disk<W>(
+                circuit,
+                3001,
+                false,
+                true,
+                tmp,
+                SampleFormat::SAMPLE_FORMAT_01,
+                rng,
+                tmp,
+                SampleFormat::SAMPLE_FORMAT_01);
+        },
+        std::out_of_range);
+    fclose(tmp);
+})
+
 TEST_EACH_WORD_SIZE_W(DetectionSimulator, stream_many_shots, {
     auto rng = INDEPENDENT_TEST_RNG();
     DebugForceResultStreamingRaii force_streaming;
@@ -472,3 +521,53 @@ TEST_EACH_WORD_SIZE_W(DetectionSimulator, obs_data, {
         ASSERT_EQ(obs_saved[k], 0x3);
     }
 })
+
+TEST_EACH_WORD_SIZE_W(DetectionSimulator, obs_data_streamed_over_many_batches, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    DebugForceResultStreamingRaii force_streaming;
+    auto circuit = Circuit(R"circuit(
+        REPEAT 399 {
+            X_ERROR(1) 0
+            MR 0
+            DETECTOR rec[-1]
+        }
+        REPEAT 600 {
+            MR 0
+            DETECTOR rec[-1]
+            OBSERVABLE_INCLUDE(0) rec[-1]
+        }
+        X_ERROR(1) 0
+        MR 0
+        OBSERVABLE_INCLUDE(0) rec[-1]
+        OBSERVABLE_INCLUDE(1) rec[-1]
+        MR 0
+        OBSERVABLE_INCLUDE(2) rec[-1]
+    )circuit");
+    FILE *det_tmp = tmpfile();
+    FILE *obs_tmp = tmpfile();
+    sample_batch_detection_events_writing_results_to_disk<W>(
+        circuit,
+        1001,
+        false,
+        false,
+        det_tmp,
+        SampleFormat::SAMPLE_FORMAT_B8,
+        rng,
+        obs_tmp,
+        SampleFormat::SAMPLE_FORMAT_B8);
+
+    auto det_saved = rewind_read_close(det_tmp);
+    auto obs_saved = rewind_read_close(obs_tmp);
+    ASSERT_EQ(det_saved.size(), 125 * 1001);
+    ASSERT_EQ(obs_saved.size(), 1 * 1001);
+    for (size_t k = 0; k < det_saved.size(); k++) {
+        for (size_t b = 0; b < 8; b++) {
+            size_t det_index = (k % 125) * 8 + b;
+            bool bit = (((uint8_t)det_saved[k]) >> b) & 1;
+            ASSERT_EQ(bit, det_index < 399) << k;
+        }
+    }
+    for (size_t k = 0; k < obs_saved.size(); k++) {
+        ASSERT_EQ(obs_saved[k], 0x3);
+    }
+})
@@ -26,6 +26,7 @@
 
 #include "stim/circuit/circuit.h"
 #include "stim/io/measure_record.h"
+#include "stim/io/measure_record_index.h"
 #include "stim/stabilizers/tableau.h"
 #include "stim/stabilizers/tableau_transposed_raii.h"
 
@@ -47,6 +48,10 @@ namespace stim {
 ///         all-zeroes instead of being collected from the circuit. This should probably only be done if you know the
 ///         all-zero sample is a valid sample, or if you know that the measurements were generated by a frame simulator
 ///         that was also incorrectly assuming an all-zero reference sample.
+///     shot_offset: The number of shots at the start of the measurement (and sweep) data to skip over.
+///     max_shots: The maximum number of shots to convert, starting from `shot_offset`.
+///     measurements_in_index: An optional index of the measurement data file, used to seek directly to `shot_offset`
+///         instead of reading and discarding the skipped shots.
 template <size_t W>
 void stream_measurements_to_detection_events(
     FILE *measurements_in,
@@ -59,7 +64,10 @@ void stream_measurements_to_detection_events(
     bool append_observables,
     bool skip_reference_sample,
     FILE *obs_out,
-    SampleFormat obs_out_format);
+    SampleFormat obs_out_format,
+    uint64_t shot_offset = 0,
+    uint64_t max_shots = UINT64_MAX,
+    const MeasureRecordIndex *measurements_in_index = nullptr);
 
 /// A variant of `stim::stream_measurements_to_detection_events` with derived values passed in, not recomputed.
 template <size_t W>
@@ -75,7 +83,10 @@ void stream_measurements_to_detection_events_helper(
     bool append_observables,
     simd_bits_range_ref<W> reference_sample,
     FILE *obs_out,
-    SampleFormat obs_out_format);
+    SampleFormat obs_out_format,
+    uint64_t shot_offset = 0,
+    uint64_t max_shots = UINT64_MAX,
+    const MeasureRecordIndex *measurements_in_index = nullptr);
 
 /// Converts measurement data into detection event data based on a circuit.
 ///
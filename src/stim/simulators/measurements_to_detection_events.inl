@@ -162,7 +162,10 @@ void stream_measurements_to_detection_events(
     bool append_observables,
     bool skip_reference_sample,
     FILE *obs_out,
-    SampleFormat obs_out_format) {
+    SampleFormat obs_out_format,
+    uint64_t shot_offset,
+    uint64_t max_shots,
+    const MeasureRecordIndex *measurements_in_index) {
     // Circuit metadata.
     CircuitStats circuit_stats = circuit.compute_stats();
     simd_bits<W> reference_sample(circuit_stats.num_measurements);
@@ -183,7 +186,10 @@ void stream_measurements_to_detection_events(
         append_observables,
         reference_sample,
         obs_out,
-        obs_out_format);
+        obs_out_format,
+        shot_offset,
+        max_shots,
+        measurements_in_index);
 }
 
 template <size_t W>
@@ -199,7 +205,10 @@ void stream_measurements_to_detection_events_helper(
     bool append_observables,
     simd_bits_range_ref<W> reference_sample,
     FILE *obs_out,
-    SampleFormat obs_out_format) {
+    SampleFormat obs_out_format,
+    uint64_t shot_offset,
+    uint64_t max_shots,
+    const MeasureRecordIndex *measurements_in_index) {
     bool internally_append_observables = append_observables || obs_out != nullptr;
     size_t num_out_bits_including_any_obs =
         circuit_stats.num_detectors + circuit_stats.num_observables * internally_append_observables;
@@ -207,7 +216,13 @@ void stream_measurements_to_detection_events_helper(
     size_t num_buffered_shots = 1024;
 
     // Readers / writers.
-    auto reader = MeasureRecordReader<W>::make(measurements_in, measurements_in_format, circuit_stats.num_measurements);
+    auto reader = MeasureRecordReader<W>::make_for_record_range(
+        measurements_in,
+        measurements_in_format,
+        shot_offset,
+        max_shots,
+        measurements_in_index,
+        circuit_stats.num_measurements);
     std::unique_ptr<MeasureRecordReader<W>> sweep_data_reader;
     std::unique_ptr<MeasureRecordWriter> obs_writer;
     if (obs_out != nullptr) {
@@ -215,8 +230,13 @@ void stream_measurements_to_detection_events_helper(
     }
     auto writer = MeasureRecordWriter::make(results_out, results_out_format);
     if (optional_sweep_bits_in != nullptr) {
-        sweep_data_reader =
-            MeasureRecordReader<W>::make(optional_sweep_bits_in, sweep_bits_in_format, circuit_stats.num_sweep_bits);
+        sweep_data_reader = MeasureRecordReader<W>::make_for_record_range(
+            optional_sweep_bits_in,
+            sweep_bits_in_format,
+            shot_offset,
+            max_shots,
+            nullptr,
+            circuit_stats.num_sweep_bits);
     }
 
     // Buffers and transposed buffers.
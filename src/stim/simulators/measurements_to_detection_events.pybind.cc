@@ -20,6 +20,7 @@
 #include "stim/py/numpy.pybind.h"
 #include "stim/simulators/measurements_to_detection_events.h"
 #include "stim/simulators/tableau_simulator.h"
+#include "stim/util_top/reference_sample_tree.h"
 
 using namespace stim;
 using namespace stim_pybind;
@@ -155,7 +156,7 @@ CompiledMeasurementsToDetectionEventsConverter stim_pybind::py_init_compiled_mea
     const Circuit &circuit, bool skip_reference_sample) {
     simd_bits<MAX_BITWORD_WIDTH> ref_sample =
         skip_reference_sample ? simd_bits<MAX_BITWORD_WIDTH>(circuit.count_measurements())
-                              : TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(circuit);
+                              : reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit);
     return CompiledMeasurementsToDetectionEventsConverter(ref_sample, circuit, skip_reference_sample);
 }
 
@@ -225,11 +226,11 @@ void stim_pybind::pybind_compiled_measurements_to_detection_events_converter_met
             Args:
                 measurements_filepath: A file containing measurement data to be converted.
                 measurements_format: The format the measurement data is stored in.
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
                 detection_events_filepath: Where to save detection event data to.
                 detection_events_format: The format to save the detection event data in.
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
                 sweep_bits_filepath: Defaults to None. A file containing sweep data, or
                     None. When specified, sweep data (used for `sweep[k]` controls in the
@@ -237,14 +238,14 @@ void stim_pybind::pybind_compiled_measurements_to_detection_events_converter_met
                     file. When not specified, all sweep bits default to False and no
                     sweep-controlled operations occur.
                 sweep_bits_format: The format the sweep data is stored in.
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
                 obs_out_filepath: Sample observables as part of each shot, and write them to
                     this file. This keeps the observable data separate from the detector
                     data.
                 obs_out_format: If writing the observables to a file, this is the format to
                     write them in.
-                    Valid values are "01", "b8", "r8", "hits", "dets", and "ptb64".
+                    Valid values are "01", "b8", "r8", "rice", "hits", "dets", and "ptb64".
                     Defaults to "01".
                 append_observables: When True, the observables in the circuit are included
                     as part of the detection event data. Specifically, they are treated as
@@ -228,7 +228,7 @@ TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, empty_cases, {
         false,
         false);
     ASSERT_EQ(converted.num_major_bits_padded(), 0);
-    ASSERT_EQ(converted.num_minor_bits_padded(), 256);
+    ASSERT_EQ(converted.num_minor_bits_padded(), std::max<size_t>(W, 256));
 
     converted = measurements_to_detection_events(
         measurement_data,
@@ -240,7 +240,7 @@ TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, empty_cases, {
         false,
         false);
     ASSERT_EQ(converted.num_major_bits_padded(), 0);
-    ASSERT_EQ(converted.num_minor_bits_padded(), 256);
+    ASSERT_EQ(converted.num_minor_bits_padded(), std::max<size_t>(W, 256));
 })
 
 TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, big_shots, {
@@ -288,11 +288,11 @@ TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, big_data, {
         false,
         false);
     ASSERT_EQ(converted[0].popcnt(), 0);
-    ASSERT_EQ(converted[1].popcnt(), 256);
+    ASSERT_EQ(converted[1].popcnt(), converted.num_minor_bits_padded());
     ASSERT_EQ(converted[2].popcnt(), 0);
-    ASSERT_EQ(converted[3].popcnt(), 256);
+    ASSERT_EQ(converted[3].popcnt(), converted.num_minor_bits_padded());
     ASSERT_EQ(converted[398].popcnt(), 0);
-    ASSERT_EQ(converted[399].popcnt(), 256);
+    ASSERT_EQ(converted[399].popcnt(), converted.num_minor_bits_padded());
     ASSERT_EQ(converted[400].popcnt(), 0);
     ASSERT_EQ(converted[401].popcnt(), 0);
 })
@@ -315,7 +315,7 @@ TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, append_observables, {
         true,
         false);
     ASSERT_EQ(converted.num_major_bits_padded(), min_bits);
-    ASSERT_EQ(converted.num_minor_bits_padded(), 256);
+    ASSERT_EQ(converted.num_minor_bits_padded(), std::max<size_t>(W, 256));
     ASSERT_EQ(converted[0][0], 0);
     ASSERT_EQ(converted[1][0], 0);
     ASSERT_EQ(converted[9][0], 1);
@@ -333,7 +333,7 @@ TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, append_observables, {
         true,
         false);
     ASSERT_EQ(converted.num_major_bits_padded(), min_bits);
-    ASSERT_EQ(converted.num_minor_bits_padded(), 256);
+    ASSERT_EQ(converted.num_minor_bits_padded(), std::max<size_t>(W, 256));
     ASSERT_EQ(converted[0][0], 1);
     ASSERT_EQ(converted[1][0], 1);
     ASSERT_EQ(converted[9][0], 0);
@@ -351,7 +351,7 @@ TEST_EACH_WORD_SIZE_W(measurements_to_detection_events, append_observables, {
         false,
         false);
     ASSERT_EQ(converted.num_major_bits_padded(), 0);
-    ASSERT_EQ(converted.num_minor_bits_padded(), 256);
+    ASSERT_EQ(converted.num_minor_bits_padded(), std::max<size_t>(W, 256));
     converted = measurements_to_detection_events(
         measurement_data,
         sweep_data,
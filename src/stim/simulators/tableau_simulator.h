@@ -43,6 +43,11 @@ struct TableauSimulator {
     int8_t sign_bias;
     MeasureRecord measurement_record;
     bool last_correlated_error_occurred;
+    /// When not null, `inv_state` is currently transposed and this is the value responsible for undoing it.
+    ///
+    /// This is set by `safe_do_circuit` while it's running a stretch of Z basis collapses that can share a single
+    /// transposition. Only operations that `can_do_while_transposed` accepts are performed while it's set.
+    TableauTransposedRaii<W> *transposed_inv_state;
 
     /// Args:
     ///     num_qubits: The initial number of qubits in the simulator state.
@@ -96,7 +101,15 @@ struct TableauSimulator {
     /// Runs all of the operations in the given circuit.
     ///
     /// Automatically expands the tableau simulator's state, if needed.
+    ///
+    /// Consecutive Z basis measurements and resets share one transposition of the state, instead of each
+    /// transposing it in and back out, as long as the operations between them only affect sign bits.
     void safe_do_circuit(const Circuit &circuit, uint64_t reps = 1);
+    /// Determines if an operation can be performed while the state is transposed for Z basis collapses.
+    ///
+    /// This is true for Z basis measurements and resets, and for operations that don't touch the tableau's X/Z
+    /// bit tables (annotations, Pauli gates, and Pauli noise).
+    static bool can_do_while_transposed(GateType gate_type);
     void do_operation_ensure_size(const CircuitInstruction &operation);
 
     void apply_tableau(const Tableau<W> &tableau, const std::vector<size_t> &targets);
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <optional>
 #include <set>
 
 #include "stim/circuit/gate_decomposition.h"
@@ -28,7 +29,8 @@ TableauSimulator<W>::TableauSimulator(std::mt19937_64 &&rng, size_t num_qubits,
       rng(std::move(rng)),
       sign_bias(sign_bias),
       measurement_record(std::move(record)),
-      last_correlated_error_occurred(false) {
+      last_correlated_error_occurred(false),
+      transposed_inv_state(nullptr) {
 }
 
 template <size_t W>
@@ -37,7 +39,8 @@ TableauSimulator<W>::TableauSimulator(const TableauSimulator<W> &other, std::mt1
       rng(std::move(rng)),
       sign_bias(other.sign_bias),
       measurement_record(other.measurement_record),
-      last_correlated_error_occurred(other.last_correlated_error_occurred) {
+      last_correlated_error_occurred(other.last_correlated_error_occurred),
+      transposed_inv_state(nullptr) {
 }
 
 template <size_t W>
@@ -1240,6 +1243,14 @@ void TableauSimulator<W>::collapse_y(SpanRef<const GateTarget> targets, size_t s
 
 template <size_t W>
 void TableauSimulator<W>::collapse_z(SpanRef<const GateTarget> targets, size_t stride) {
+    if (transposed_inv_state != nullptr) {
+        // Already transposed. Deterministic targets are detected (and skipped) by the collapse itself.
+        for (size_t k = 0; k < targets.size(); k += stride) {
+            collapse_qubit_z(targets[k].data & TARGET_VALUE_MASK, *transposed_inv_state);
+        }
+        return;
+    }
+
     // Find targets that need to be collapsed.
     std::vector<GateTarget> collapse_targets;
     collapse_targets.reserve(targets.size());
@@ -1276,11 +1287,14 @@ size_t TableauSimulator<W>::collapse_qubit_z(size_t target, TableauTransposedRai
 
     // Perform partial Gaussian elimination over the stabilizer generators that anti-commute with the measurement.
     // Do this by introducing no-effect-because-control-is-zero CNOTs at the beginning of time.
+    // (The CNOTs don't change which generators anti-commute, so they can be collected up front and fused.)
+    std::vector<size_t> anti_commuting;
     for (size_t k = pivot + 1; k < n; k++) {
         if (transposed_raii.tableau.zs.xt[k][target]) {
-            transposed_raii.append_ZCX(pivot, k);
+            anti_commuting.push_back(k);
         }
     }
+    transposed_raii.append_ZCX_fanout(pivot, anti_commuting);
 
     // Swap the now-isolated anti-commuting stabilizer generator for one that commutes with the measurement.
     if (transposed_raii.tableau.zs.zt[pivot][target]) {
@@ -1316,12 +1330,14 @@ void TableauSimulator<W>::collapse_isolate_qubit_z(size_t target, TableauTranspo
     }
 
     // Ensure T(Z_target) = +-Z_target.
+    std::vector<size_t> z_terms;
     for (size_t q = 0; q < n; q++) {
         if (q != target && transposed_raii.tableau.zs.zt[q][target]) {
             // Cancel Z term on non-target q.
-            transposed_raii.append_ZCX(q, target);
+            z_terms.push_back(q);
         }
     }
+    transposed_raii.append_ZCX_fanin(z_terms, target);
 
     // Note T(X_target) now contains X_target or Y_target because it has to anti-commute with T(Z_target) = Z_target.
     // Ensure T(X_target) contains X_target instead of Y_target.
@@ -1347,10 +1363,63 @@ void TableauSimulator<W>::collapse_isolate_qubit_z(size_t target, TableauTranspo
 template <size_t W>
 void TableauSimulator<W>::safe_do_circuit(const Circuit &circuit, uint64_t reps) {
     ensure_large_enough_for_qubits(circuit.count_qubits());
-    for (uint64_t k = 0; k < reps; k++) {
-        circuit.for_each_operation([&](const CircuitInstruction &op) {
-            do_gate(op);
-        });
+
+    std::optional<TableauTransposedRaii<W>> transposed;
+    auto stop_transposing = [&]() {
+        transposed_inv_state = nullptr;
+        transposed.reset();
+    };
+    try {
+        for (uint64_t k = 0; k < reps; k++) {
+            circuit.for_each_operation([&](const CircuitInstruction &op) {
+                if (transposed.has_value() && !can_do_while_transposed(op.gate_type)) {
+                    stop_transposing();
+                }
+                if (!transposed.has_value() &&
+                    (op.gate_type == GateType::M || op.gate_type == GateType::MR || op.gate_type == GateType::R)) {
+                    // Only start transposing when a collapse is actually needed.
+                    for (const auto &t : op.targets) {
+                        if (!is_deterministic_z(t.qubit_value())) {
+                            transposed.emplace(inv_state);
+                            transposed_inv_state = &*transposed;
+                            break;
+                        }
+                    }
+                }
+                do_gate(op);
+            });
+        }
+    } catch (...) {
+        stop_transposing();
+        throw;
+    }
+    stop_transposing();
+}
+
+template <size_t W>
+bool TableauSimulator<W>::can_do_while_transposed(GateType gate_type) {
+    switch (gate_type) {
+        case GateType::M:
+        case GateType::MR:
+        case GateType::R:
+        case GateType::MPAD:
+        case GateType::I:
+        case GateType::X:
+        case GateType::Y:
+        case GateType::Z:
+        case GateType::X_ERROR:
+        case GateType::Y_ERROR:
+        case GateType::Z_ERROR:
+        case GateType::DEPOLARIZE1:
+        case GateType::DEPOLARIZE2:
+        case GateType::DETECTOR:
+        case GateType::OBSERVABLE_INCLUDE:
+        case GateType::TICK:
+        case GateType::QUBIT_COORDS:
+        case GateType::SHIFT_COORDS:
+            return true;
+        default:
+            return false;
     }
 }
 
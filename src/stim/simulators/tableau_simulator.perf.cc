@@ -35,3 +35,45 @@ BENCHMARK(TableauSimulator_CX_10Kqubits) {
         .goal_millis(5)
         .show_rate("OpQubits", targets.size());
 }
+
+BENCHMARK(TableauSimulator_measure_random_state_2Kqubits) {
+    size_t num_qubits = 2 * 1000;
+    std::mt19937_64 rng(0);
+    auto state = Tableau<MAX_BITWORD_WIDTH>::random(num_qubits, rng);
+    TableauSimulator<MAX_BITWORD_WIDTH> sim(std::mt19937_64(0), num_qubits);
+
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        targets.push_back(GateTarget{k});
+    }
+    CircuitInstruction op_data{GateType::M, {}, targets};
+
+    benchmark_go([&]() {
+        sim.inv_state = state;
+        sim.measurement_record.storage.clear();
+        sim.do_MZ(op_data);
+    })
+        .goal_millis(400)
+        .show_rate("Measurements", targets.size());
+}
+
+BENCHMARK(TableauSimulator_measure_one_qubit_per_instruction_1Kqubits) {
+    size_t num_qubits = 1000;
+    std::mt19937_64 rng(0);
+    auto state = Tableau<MAX_BITWORD_WIDTH>::random(num_qubits, rng);
+    TableauSimulator<MAX_BITWORD_WIDTH> sim(std::mt19937_64(0), num_qubits);
+
+    Circuit circuit;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        circuit.safe_append_u("M", {k});
+        circuit.safe_append_u("TICK", {});
+    }
+
+    benchmark_go([&]() {
+        sim.inv_state = state;
+        sim.measurement_record.storage.clear();
+        sim.safe_do_circuit(circuit);
+    })
+        .goal_millis(20)
+        .show_rate("Measurements", num_qubits);
+}
@@ -2434,3 +2434,60 @@ TEST_EACH_WORD_SIZE_W(TableauSimulator, postselect_observable, {
     sim.postselect_observable(PauliString<W>("XZ"), true);
     ASSERT_NE(sim.inv_state, initial_state);
 })
+
+TEST_EACH_WORD_SIZE_W(TableauSimulator, safe_do_circuit_shares_transposes_between_collapses, {
+    Circuit circuit(R"CIRCUIT(
+        H 0 1 2 3 4 5 6 7 8 9
+        CX 0 10 1 11 2 12 3 13 4 14 5 15
+        M 0
+        X_ERROR(0.25) 1 2
+        M 1
+        DETECTOR rec[-1] rec[-2]
+        MPAD 1
+        TICK
+        DEPOLARIZE1(0.25) 3
+        DEPOLARIZE2(0.25) 4 5
+        MR 2 3 3
+        X 4
+        Y 5
+        Z 6
+        R 4 5 7
+        M 8 9 10 11 12 13 14 15
+        H 0
+        M 0 1
+        REPEAT 3 {
+            H 16
+            M(0.125) 16
+            R 16
+            M 16
+        }
+        CX 0 1
+        M 0 1
+    )CIRCUIT");
+
+    for (uint64_t seed = 0; seed < 10; seed++) {
+        TableauSimulator<W> batched(std::mt19937_64(seed), circuit.count_qubits());
+        batched.safe_do_circuit(circuit);
+        ASSERT_EQ(batched.transposed_inv_state, nullptr);
+
+        TableauSimulator<W> one_at_a_time(std::mt19937_64(seed), circuit.count_qubits());
+        circuit.for_each_operation([&](const CircuitInstruction &op) {
+            one_at_a_time.do_gate(op);
+        });
+
+        ASSERT_EQ(batched.measurement_record.storage, one_at_a_time.measurement_record.storage);
+        ASSERT_EQ(batched.inv_state, one_at_a_time.inv_state);
+    }
+})
+
+TEST_EACH_WORD_SIZE_W(TableauSimulator, can_do_while_transposed, {
+    ASSERT_TRUE(TableauSimulator<W>::can_do_while_transposed(GateType::M));
+    ASSERT_TRUE(TableauSimulator<W>::can_do_while_transposed(GateType::MR));
+    ASSERT_TRUE(TableauSimulator<W>::can_do_while_transposed(GateType::R));
+    ASSERT_TRUE(TableauSimulator<W>::can_do_while_transposed(GateType::X_ERROR));
+    ASSERT_TRUE(TableauSimulator<W>::can_do_while_transposed(GateType::DETECTOR));
+    ASSERT_FALSE(TableauSimulator<W>::can_do_while_transposed(GateType::MX));
+    ASSERT_FALSE(TableauSimulator<W>::can_do_while_transposed(GateType::H));
+    ASSERT_FALSE(TableauSimulator<W>::can_do_while_transposed(GateType::CX));
+    ASSERT_FALSE(TableauSimulator<W>::can_do_while_transposed(GateType::HERALDED_ERASE));
+})
@@ -215,7 +215,7 @@ TEST_EACH_WORD_SIZE_W(pauli_string, move_copy_assignment, {
 
 TEST_EACH_WORD_SIZE_W(pauli_string, foreign_memory, {
     auto rng = INDEPENDENT_TEST_RNG();
-    size_t bits = 2048;
+    size_t bits = std::max<size_t>(2048, 8 * W);
     auto buffer = simd_bits<W>::random(bits, rng);
     bool signs = false;
     size_t num_qubits = W * 2 - 12;
@@ -131,7 +131,7 @@ uint8_t PauliStringRef<W>::inplace_right_mul_returning_log_i_scalar(const PauliS
             // At each bit position: accumulate anti-commutation (+i or -i) counts.
             auto x1z2 = old_x1 & z2;
             auto anti_commutes = (x2 & old_z1) ^ x1z2;
-            cnt2 ^= (cnt1 ^ x1 ^ z1 ^ x1z2) & anti_commutes;
+            cnt2 ^= (xor3(cnt1, x1, z1) ^ x1z2) & anti_commutes;
             cnt1 ^= anti_commutes;
         });
 
@@ -28,6 +28,11 @@
 
 namespace stim {
 
+/// Tableaus with at least this many qubits are composed by `Tableau::then` using the method of four russians.
+constexpr size_t TABLEAU_THEN_FOUR_RUSSIANS_MIN_QUBITS = 32;
+/// Operations with at most this many qubits are appended by `Tableau::inplace_scatter_append` via a lookup table.
+constexpr size_t TABLEAU_SCATTER_APPEND_LOOKUP_MAX_QUBITS = 4;
+
 template <size_t W>
 struct TableauHalf {
     size_t num_qubits;
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -180,11 +182,45 @@ void Tableau<W>::inplace_scatter_append(const Tableau<W> &operation, const std::
         inplace_scatter_append(independent_copy, target_qubits);
         return;
     }
+    size_t k = operation.num_qubits;
+    if (k > TABLEAU_SCATTER_APPEND_LOOKUP_MAX_QUBITS) {
+        for (size_t q = 0; q < num_qubits; q++) {
+            auto x = xs[q];
+            auto z = zs[q];
+            operation.apply_within(x, target_qubits);
+            operation.apply_within(z, target_qubits);
+        }
+        return;
+    }
+
+    // Small operations are applied by looking up the image of every possible input pauli, instead of
+    // gathering, evaluating, and scattering a temporary pauli string for each row.
+    std::vector<PauliString<W>> images;
+    images.reserve(size_t{1} << (2 * k));
+    for (size_t m = 0; m < (size_t{1} << (2 * k)); m++) {
+        PauliString<W> p(k);
+        for (size_t j = 0; j < k; j++) {
+            p.xs[j] = (m >> j) & 1;
+            p.zs[j] = (m >> (k + j)) & 1;
+        }
+        images.push_back(operation(p.ref()));
+    }
+    auto apply = [&](PauliStringRef<W> row) {
+        size_t m = 0;
+        for (size_t j = 0; j < k; j++) {
+            m |= (size_t)row.xs[target_qubits[j]] << j;
+            m |= (size_t)row.zs[target_qubits[j]] << (k + j);
+        }
+        const auto &image = images[m];
+        row.sign ^= image.sign;
+        for (size_t j = 0; j < k; j++) {
+            row.xs[target_qubits[j]] = image.xs[j];
+            row.zs[target_qubits[j]] = image.zs[j];
+        }
+    };
     for (size_t q = 0; q < num_qubits; q++) {
-        auto x = xs[q];
-        auto z = zs[q];
-        operation.apply_within(x, target_qubits);
-        operation.apply_within(z, target_qubits);
+        apply(xs[q]);
+        apply(zs[q]);
     }
 }
 
@@ -512,10 +548,73 @@ void Tableau<W>::do_transpose_quadrants() {
 template <size_t W>
 Tableau<W> Tableau<W>::then(const Tableau<W> &second) const {
     assert(num_qubits == second.num_qubits);
-    Tableau<W> result(num_qubits);
-    for (size_t q = 0; q < num_qubits; q++) {
-        result.xs[q] = second(xs[q]);
-        result.zs[q] = second(zs[q]);
+    size_t n = num_qubits;
+    if (n < TABLEAU_THEN_FOUR_RUSSIANS_MIN_QUBITS) {
+        Tableau<W> result(n);
+        for (size_t q = 0; q < n; q++) {
+            result.xs[q] = second(xs[q]);
+            result.zs[q] = second(zs[q]);
+        }
+        return result;
+    }
+
+    // Method of Four Russians. An input pauli P = s * i^popcount(x & z) * prod_q X_q^x_q * prod_q Z_q^z_q maps to
+    // the same ordered product of the second tableau's X outputs then Z outputs. Those outputs are consumed in
+    // groups of 8, with all 256 ordered products of a group precomputed, so each output row only needs one pauli
+    // multiplication per group instead of one per set bit. Phases are tallied separately as powers of i.
+    Tableau<W> result(n);
+    result.xs.xt.clear();
+    result.xs.zt.clear();
+    result.zs.xt.clear();
+    result.zs.zt.clear();
+    std::vector<uint8_t> log_i(2 * n);
+    for (size_t q = 0; q < n; q++) {
+        for (size_t h = 0; h < 2; h++) {
+            const auto &half = h == 0 ? xs : zs;
+            size_t y_count = 0;
+            for (size_t w = 0; w < half.xt[q].num_u64_padded(); w++) {
+                y_count += std::popcount(half.xt[q].u64[w] & half.zt[q].u64[w]);
+            }
+            log_i[h * n + q] = (uint8_t)(y_count + 2 * half.signs[q]);
+        }
+    }
+
+    std::vector<PauliString<W>> combos(256, PauliString<W>(n));
+    std::array<uint8_t, 256> combo_log_i{};
+    for (size_t g = 0; g < 2; g++) {
+        const auto &gens = g == 0 ? second.xs : second.zs;
+        for (size_t base = 0; base < n; base += 8) {
+            size_t group_size = std::min<size_t>(8, n - base);
+            for (size_t k = 0; k < group_size; k++) {
+                size_t bit = size_t{1} << k;
+                for (size_t s = 0; s < bit; s++) {
+                    combos[bit | s].xs = combos[s].xs;
+                    combos[bit | s].zs = combos[s].zs;
+                    combo_log_i[bit | s] =
+                        combo_log_i[s] + combos[bit | s].ref().inplace_right_mul_returning_log_i_scalar(gens[base + k]);
+                }
+            }
+
+            uint8_t mask = (uint8_t)((1 << group_size) - 1);
+            for (size_t h = 0; h < 2; h++) {
+                const auto &half = h == 0 ? xs : zs;
+                const auto &bits = g == 0 ? half.xt : half.zt;
+                auto &out = h == 0 ? result.xs : result.zs;
+                for (size_t q = 0; q < n; q++) {
+                    uint8_t s = bits[q].u8[base >> 3] & mask;
+                    if (s) {
+                        auto row = out[q];
+                        log_i[h * n + q] += combo_log_i[s] + row.inplace_right_mul_returning_log_i_scalar(combos[s].ref());
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t q = 0; q < n; q++) {
+        assert((log_i[q] & 1) == 0 && (log_i[n + q] & 1) == 0);
+        result.xs.signs[q] = (log_i[q] & 2) != 0;
+        result.zs.signs[q] = (log_i[n + q] & 2) != 0;
     }
     return result;
 }
@@ -61,3 +61,23 @@ BENCHMARK(tableau_cnot_10Kqubits) {
         t.prepend_ZCX(5, 20);
     }).goal_nanos(170);
 }
+
+BENCHMARK(tableau_then_1Kqubits) {
+    size_t n = 1000;
+    std::mt19937_64 rng(0);
+    auto t1 = Tableau<MAX_BITWORD_WIDTH>::random(n, rng);
+    auto t2 = Tableau<MAX_BITWORD_WIDTH>::random(n, rng);
+    benchmark_go([&]() {
+        t1 = t1.then(t2);
+    }).goal_millis(15);
+}
+
+BENCHMARK(tableau_then_4Kqubits) {
+    size_t n = 4000;
+    std::mt19937_64 rng(0);
+    auto t1 = Tableau<MAX_BITWORD_WIDTH>::random(n, rng);
+    auto t2 = Tableau<MAX_BITWORD_WIDTH>::random(n, rng);
+    benchmark_go([&]() {
+        t1 = t1.then(t2);
+    }).goal_millis(700);
+}
@@ -286,6 +286,22 @@ TEST_EACH_WORD_SIZE_W(tableau, inplace_scatter_append, {
     ASSERT_EQ(t3(PauliString<W>::from_str("IZ")), PauliString<W>::from_str("-ZY"));
 })
 
+TEST_EACH_WORD_SIZE_W(tableau, inplace_scatter_append_vs_then, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    for (size_t k = 1; k <= TABLEAU_SCATTER_APPEND_LOOKUP_MAX_QUBITS + 1; k++) {
+        auto t = Tableau<W>::random(8, rng);
+        auto op = Tableau<W>::random(k, rng);
+        std::vector<size_t> targets{6, 1, 4, 0, 7};
+        targets.resize(k);
+
+        Tableau<W> embedded(8);
+        embedded.inplace_scatter_prepend(op, targets);
+        auto expected = t.then(embedded);
+        t.inplace_scatter_append(op, targets);
+        ASSERT_EQ(t, expected) << k;
+    }
+})
+
 TEST_EACH_WORD_SIZE_W(tableau, inplace_scatter_prepend, {
     auto t1 = Tableau<W>::identity(1);
     t1.inplace_scatter_prepend(GATE_DATA.at("SQRT_Z").tableau<W>(), {0});
@@ -628,6 +644,43 @@ TEST_EACH_WORD_SIZE_W(tableau, specialized_operation, {
         }));
 })
 
+TEST_EACH_WORD_SIZE_W(tableau, transposed_append_ZCX_fanout_and_fanin, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    for (size_t n : std::vector<size_t>{3, 70, 600}) {
+        auto t = Tableau<W>::random(n, rng);
+        std::vector<size_t> others;
+        for (size_t q = 1; q < n; q += 2) {
+            others.push_back(q);
+        }
+
+        auto expected = t;
+        auto actual = t;
+        {
+            TableauTransposedRaii<W> trans(expected);
+            for (auto q : others) {
+                trans.append_ZCX(0, q);
+            }
+        }
+        TableauTransposedRaii<W>(actual).append_ZCX_fanout(0, others);
+        ASSERT_EQ(actual, expected);
+
+        expected = t;
+        actual = t;
+        {
+            TableauTransposedRaii<W> trans(expected);
+            for (auto q : others) {
+                trans.append_ZCX(q, 0);
+            }
+        }
+        TableauTransposedRaii<W>(actual).append_ZCX_fanin(others, 0);
+        ASSERT_EQ(actual, expected);
+
+        actual = t;
+        TableauTransposedRaii<W>(actual).append_ZCX_fanout(0, {});
+        ASSERT_EQ(actual, t);
+    }
+})
+
 TEST_EACH_WORD_SIZE_W(tableau, expand, {
     auto rng = INDEPENDENT_TEST_RNG();
     auto t = Tableau<W>::random(4, rng);
@@ -811,6 +864,21 @@ TEST_EACH_WORD_SIZE_W(tableau, then, {
     ASSERT_EQ(t, GATE_DATA.at("CZ").tableau<W>());
 })
 
+TEST_EACH_WORD_SIZE_W(tableau, then_four_russians_matches_pauli_evaluation, {
+    auto rng = INDEPENDENT_TEST_RNG();
+    for (size_t n : std::vector<size_t>{TABLEAU_THEN_FOUR_RUSSIANS_MIN_QUBITS, 37, 64, 101}) {
+        auto t1 = Tableau<W>::random(n, rng);
+        auto t2 = Tableau<W>::random(n, rng);
+        Tableau<W> expected(n);
+        for (size_t q = 0; q < n; q++) {
+            expected.xs[q] = t2(t1.xs[q]);
+            expected.zs[q] = t2(t1.zs[q]);
+        }
+        ASSERT_EQ(t1.then(t2), expected) << n;
+        ASSERT_EQ(t1.then(t1.inverse()), Tableau<W>(n)) << n;
+    }
+})
+
 TEST_EACH_WORD_SIZE_W(tableau, raised_to, {
     auto cnot = GATE_DATA.at("CNOT").tableau<W>();
     ASSERT_EQ(cnot.raised_to(-97268202), Tableau<W>(2));
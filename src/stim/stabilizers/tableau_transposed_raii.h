@@ -22,6 +22,7 @@
 
 #include "stim/mem/simd_bit_table.h"
 #include "stim/mem/simd_util.h"
+#include "stim/mem/span_ref.h"
 #include "stim/stabilizers/pauli_string.h"
 #include "stim/stabilizers/tableau.h"
 
@@ -52,6 +53,16 @@ struct TableauTransposedRaii {
     void append_H_YZ(size_t q);
     void append_S(size_t q);
     void append_ZCX(size_t control, size_t target);
+    /// Equivalent to calling append_ZCX(control, t) for each t in targets, in order.
+    ///
+    /// The operations are fused into one pass over the affected rows. For large tableaus the pass is split
+    /// into ranges of words, which are processed on separate threads.
+    void append_ZCX_fanout(size_t control, SpanRef<const size_t> targets);
+    /// Equivalent to calling append_ZCX(c, target) for each c in controls, in order.
+    ///
+    /// The operations are fused into one pass over the affected rows. For large tableaus the pass is split
+    /// into ranges of words, which are processed on separate threads.
+    void append_ZCX_fanin(SpanRef<const size_t> controls, size_t target);
     void append_ZCY(size_t control, size_t target);
     void append_ZCZ(size_t control, size_t target);
     void append_X(size_t q);
@@ -17,6 +17,7 @@
 
 #include "stim/stabilizers/pauli_string.h"
 #include "stim/stabilizers/tableau_transposed_raii.h"
+#include "stim/util_bot/parallel_util.h"
 
 namespace stim {
 
@@ -57,17 +58,77 @@ inline void for_each_trans_obs(TableauTransposedRaii<W> &trans, size_t q1, size_
     }
 }
 
+/// Iterates over the Paulis in a sequence of row pairs of the tableau, splitting the work over threads.
+///
+/// Each word position of the rows is independent of the others, so the words are divided into contiguous ranges
+/// and every range has the whole sequence of row pair operations applied to it before moving on. This also keeps
+/// any row shared by the pairs hot in cache.
+///
+/// Args:
+///     trans: The transposed tableau.
+///     num_pairs: The number of row pairs to iterate over.
+///     pair_at: A function taking an index less than num_pairs and returning the corresponding pair of rows.
+///     body: A function taking X1, Z1, X2, Z2, and SIGN words.
+template <size_t W, typename PAIR_FUNC, typename FUNC>
+inline void for_each_trans_obs_pair_parallel(
+    TableauTransposedRaii<W> &trans, size_t num_pairs, const PAIR_FUNC &pair_at, const FUNC &body) {
+    // Below this many word operations, the cost of starting a thread isn't worth it.
+    constexpr size_t MIN_WORDS_PER_THREAD = size_t{1} << 16;
+    size_t num_words = trans.tableau.xs.signs.num_simd_words;
+    size_t num_threads = choose_num_threads(num_words, 2 * num_pairs * num_words, MIN_WORDS_PER_THREAD);
+    parallel_for_ranges(num_words, num_threads, [&](size_t start, size_t end) {
+        size_t count = end - start;
+        for (size_t k = 0; k < 2; k++) {
+            TableauHalf<W> &h = k == 0 ? trans.tableau.xs : trans.tableau.zs;
+            auto signs = h.signs.word_range_ref(start, count);
+            for (size_t p = 0; p < num_pairs; p++) {
+                std::pair<size_t, size_t> qs = pair_at(p);
+                PauliStringRef<W> p1 = h[qs.first];
+                PauliStringRef<W> p2 = h[qs.second];
+                p1.xs.word_range_ref(start, count)
+                    .for_each_word(
+                        p1.zs.word_range_ref(start, count),
+                        p2.xs.word_range_ref(start, count),
+                        p2.zs.word_range_ref(start, count),
+                        signs,
+                        body);
+            }
+        }
+    });
+}
+
+template <size_t W>
+inline void trans_obs_zcx(simd_word<W> &cx, simd_word<W> &cz, simd_word<W> &tx, simd_word<W> &tz, simd_word<W> &s) {
+    s ^= (cz ^ tx).andnot(cx & tz);
+    cz ^= tz;
+    tx ^= cx;
+}
+
 template <size_t W>
 void TableauTransposedRaii<W>::append_ZCX(size_t control, size_t target) {
-    for_each_trans_obs<W>(
+    for_each_trans_obs<W>(*this, control, target, trans_obs_zcx<W>);
+}
+
+template <size_t W>
+void TableauTransposedRaii<W>::append_ZCX_fanout(size_t control, SpanRef<const size_t> targets) {
+    for_each_trans_obs_pair_parallel<W>(
         *this,
-        control,
-        target,
-        [](simd_word<W> &cx, simd_word<W> &cz, simd_word<W> &tx, simd_word<W> &tz, simd_word<W> &s) {
-            s ^= (cz ^ tx).andnot(cx & tz);
-            cz ^= tz;
-            tx ^= cx;
-        });
+        targets.size(),
+        [&](size_t k) {
+            return std::pair<size_t, size_t>{control, targets[k]};
+        },
+        trans_obs_zcx<W>);
+}
+
+template <size_t W>
+void TableauTransposedRaii<W>::append_ZCX_fanin(SpanRef<const size_t> controls, size_t target) {
+    for_each_trans_obs_pair_parallel<W>(
+        *this,
+        controls.size(),
+        [&](size_t k) {
+            return std::pair<size_t, size_t>{controls[k], target};
+        },
+        trans_obs_zcx<W>);
 }
 
 template <size_t W>
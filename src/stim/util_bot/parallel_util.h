@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _STIM_UTIL_BOT_PARALLEL_UTIL_H
+#define _STIM_UTIL_BOT_PARALLEL_UTIL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace stim {
+
+/// Determines how many threads to use for a job, given how much work it involves.
+///
+/// Args:
+///     max_chunks: The job can't be split into more pieces than this.
+///     total_work: An estimate of the cost of the job, in arbitrary units.
+///     min_work_per_thread: The amount of work that makes starting another thread worth it.
+///
+/// Returns:
+///     A number of threads between 1 and the hardware concurrency.
+inline size_t choose_num_threads(size_t max_chunks, size_t total_work, size_t min_work_per_thread) {
+    size_t result = std::thread::hardware_concurrency();
+    result = std::min(result, max_chunks);
+    result = std::min(result, total_work / std::max<size_t>(min_work_per_thread, 1));
+    return std::max<size_t>(result, 1);
+}
+
+/// Splits the range [0, n) into contiguous chunks, and calls `body(start, end)` for each chunk on its own thread.
+///
+/// The calling thread handles the first chunk, and waits for the others to finish before returning. When only one
+/// thread is requested, or threads can't be started, the work is done by the calling thread.
+///
+/// Since the chunks are disjoint, the result is deterministic as long as `body` only touches state belonging to the
+/// part of the range it was given. `body` must not throw.
+///
+/// Args:
+///     n: The size of the range to split up.
+///     num_threads: The number of chunks to split the range into. Usually computed with `choose_num_threads`.
+///     body: The function to call on each chunk.
+template <typename BODY>
+void parallel_for_ranges(size_t n, size_t num_threads, const BODY &body) {
+    num_threads = std::max<size_t>(std::min(num_threads, n), 1);
+    if (num_threads == 1) {
+        body((size_t)0, n);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    size_t chunk_start = n;
+    for (size_t k = num_threads - 1; k > 0; k--) {
+        size_t start = n * k / num_threads;
+        size_t end = chunk_start;
+        try {
+            threads.emplace_back([&body, start, end]() {
+                body(start, end);
+            });
+        } catch (const std::system_error &) {
+            // Couldn't start a thread. Do the chunk here instead.
+            body(start, end);
+        }
+        chunk_start = start;
+    }
+    body((size_t)0, chunk_start);
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+}  // namespace stim
+
+#endif
@@ -0,0 +1,65 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stim/util_bot/parallel_util.h"
+
+#include <mutex>
+
+#include "gtest/gtest.h"
+
+using namespace stim;
+
+TEST(parallel_util, choose_num_threads) {
+    ASSERT_EQ(choose_num_threads(0, 1000, 1), 1);
+    ASSERT_EQ(choose_num_threads(1000, 0, 1), 1);
+    ASSERT_EQ(choose_num_threads(1000, 999, 1000), 1);
+    ASSERT_EQ(choose_num_threads(1, 1000000, 1), 1);
+    ASSERT_LE(choose_num_threads(1000, 1000000, 1), std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    ASSERT_LE(choose_num_threads(2, 1000000, 1), 2);
+}
+
+TEST(parallel_util, parallel_for_ranges_covers_range_exactly_once) {
+    for (size_t n : std::vector<size_t>{0, 1, 2, 3, 17, 1000}) {
+        for (size_t num_threads : std::vector<size_t>{0, 1, 2, 3, 8}) {
+            std::vector<int> hits(n, 0);
+            std::mutex mutex;
+            std::vector<std::pair<size_t, size_t>> chunks;
+            parallel_for_ranges(n, num_threads, [&](size_t start, size_t end) {
+                for (size_t k = start; k < end; k++) {
+                    hits[k] += 1;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                chunks.push_back({start, end});
+            });
+            ASSERT_EQ(hits, std::vector<int>(n, 1));
+            ASSERT_EQ(chunks.size(), std::max<size_t>(std::min(num_threads, n), 1));
+            for (const auto &c : chunks) {
+                ASSERT_LE(c.first, c.second);
+                ASSERT_LE(c.second, n);
+            }
+        }
+    }
+}
+
+TEST(parallel_util, parallel_for_ranges_single_thread_stays_on_calling_thread) {
+    auto caller = std::this_thread::get_id();
+    size_t calls = 0;
+    parallel_for_ranges(100, 1, [&](size_t start, size_t end) {
+        ASSERT_EQ(std::this_thread::get_id(), caller);
+        ASSERT_EQ(start, 0);
+        ASSERT_EQ(end, 100);
+        calls++;
+    });
+    ASSERT_EQ(calls, 1);
+}
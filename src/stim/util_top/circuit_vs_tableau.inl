@@ -1,5 +1,6 @@
 #include "stim/simulators/graph_simulator.h"
 #include "stim/simulators/tableau_simulator.h"
+#include "stim/stabilizers/tableau_transposed_raii.h"
 #include "stim/util_top/circuit_vs_tableau.h"
 
 namespace stim {
@@ -7,11 +8,15 @@ namespace stim {
 template <size_t W>
 Tableau<W> circuit_to_tableau(
     const Circuit &circuit, bool ignore_noise, bool ignore_measurement, bool ignore_reset, bool inverse) {
-    Tableau<W> result(circuit.count_qubits());
-    TableauSimulator<W> sim(std::mt19937_64(0), circuit.count_qubits());
+    size_t num_qubits = circuit.count_qubits();
 
+    // Appending gates directly into the output tableau avoids inverting a tableau at the end, which is the
+    // dominant cost for large circuits. Gates that can't be decomposed into H+S+CX acting on plain qubit targets
+    // (e.g. classically controlled gates) fall back to prepending into the inverse tableau.
+    bool can_append = !inverse;
     circuit.for_each_operation([&](const CircuitInstruction &op) {
-        const auto &flags = GATE_DATA[op.gate_type].flags;
+        const auto &gate = GATE_DATA[op.gate_type];
+        const auto &flags = gate.flags;
         if (!ignore_measurement && (flags & GATE_PRODUCES_RESULTS)) {
             throw std::invalid_argument(
                 "The circuit has no well-defined tableau because it contains measurement operations.\n"
@@ -38,6 +43,63 @@ Tableau<W> circuit_to_tableau(
             }
         }
         if (flags & GATE_IS_UNITARY) {
+            can_append &= gate.h_s_cx_m_r_decomposition != nullptr;
+            for (const auto &t : op.targets) {
+                can_append &= t.is_qubit_target();
+            }
+        }
+    });
+
+    if (can_append) {
+        Tableau<W> result(num_qubits);
+        std::map<GateType, Circuit> decompositions;
+        {
+            TableauTransposedRaii<W> trans(result);
+            circuit.for_each_operation([&](const CircuitInstruction &op) {
+                const auto &gate = GATE_DATA[op.gate_type];
+                if (!(gate.flags & GATE_IS_UNITARY)) {
+                    return;
+                }
+                auto p = decompositions.find(op.gate_type);
+                if (p == decompositions.end()) {
+                    p = decompositions.insert({op.gate_type, Circuit(gate.h_s_cx_m_r_decomposition)}).first;
+                }
+                size_t arity = (gate.flags & GATE_TARGETS_PAIRS) ? 2 : 1;
+                for (size_t k = 0; k < op.targets.size(); k += arity) {
+                    for (const auto &step : p->second.operations) {
+                        auto qubit = [&](size_t j) {
+                            return op.targets[k + step.targets[j].qubit_value()].qubit_value();
+                        };
+                        switch (step.gate_type) {
+                            case GateType::H:
+                                for (size_t j = 0; j < step.targets.size(); j++) {
+                                    trans.append_H_XZ(qubit(j));
+                                }
+                                break;
+                            case GateType::S:
+                                for (size_t j = 0; j < step.targets.size(); j++) {
+                                    trans.append_S(qubit(j));
+                                }
+                                break;
+                            case GateType::CX:
+                                for (size_t j = 0; j < step.targets.size(); j += 2) {
+                                    trans.append_ZCX(qubit(j), qubit(j + 1));
+                                }
+                                break;
+                            default:
+                                throw std::invalid_argument(
+                                    "Unexpected operation in the decomposition of " + std::string(gate.name));
+                        }
+                    }
+                }
+            });
+        }
+        return result;
+    }
+
+    TableauSimulator<W> sim(std::mt19937_64(0), num_qubits);
+    circuit.for_each_operation([&](const CircuitInstruction &op) {
+        if (GATE_DATA[op.gate_type].flags & GATE_IS_UNITARY) {
             sim.do_gate(op);
         }
     });
@@ -0,0 +1,29 @@
+#include "stim/util_top/circuit_vs_tableau.h"
+
+#include "stim/perf.perf.h"
+
+using namespace stim;
+
+BENCHMARK(circuit_to_tableau_2Kqubits_20layers) {
+    size_t n = 2000;
+    std::mt19937_64 rng(0);
+    Circuit circuit;
+    std::vector<uint32_t> qubits(n);
+    for (size_t k = 0; k < n; k++) {
+        qubits[k] = k;
+    }
+    for (size_t layer = 0; layer < 20; layer++) {
+        std::shuffle(qubits.begin(), qubits.end(), rng);
+        circuit.safe_append_u("H", std::vector<uint32_t>(qubits.begin(), qubits.begin() + n / 2));
+        circuit.safe_append_u("CZ", qubits);
+        circuit.safe_append_u("TICK", {});
+    }
+
+    size_t total = 0;
+    benchmark_go([&]() {
+        total += circuit_to_tableau<MAX_BITWORD_WIDTH>(circuit, false, false, false).xs.signs.popcnt();
+    }).goal_millis(100);
+    if (total == 0) {
+        std::cerr << "data dependence";
+    }
+}
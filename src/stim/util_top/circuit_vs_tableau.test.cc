@@ -2,6 +2,7 @@
 
 #include "gtest/gtest.h"
 
+#include "stim/circuit/circuit.test.h"
 #include "stim/mem/simd_word.test.h"
 #include "stim/simulators/tableau_simulator.h"
 #include "stim/util_bot/test_util.test.h"
@@ -194,6 +195,30 @@ TEST_EACH_WORD_SIZE_W(conversions, circuit_to_tableau, {
         GATE_DATA.at("CX").tableau<W>());
 })
 
+TEST_EACH_WORD_SIZE_W(conversions, circuit_to_tableau_appending_matches_inverse_prepending, {
+    Circuit circuit;
+    for (const auto &g : GATE_DATA.items) {
+        if ((g.flags & GATE_IS_UNITARY) && !(g.flags & GATE_TARGETS_PAULI_STRING)) {
+            if (g.flags & GATE_TARGETS_PAIRS) {
+                circuit.safe_append_u(g.name, {2, 0, 1, 3});
+            } else {
+                circuit.safe_append_u(g.name, {1, 3, 0});
+            }
+            circuit.safe_append_u("H", {2});
+            circuit.safe_append_u("CX", {1, 2, 0, 3});
+        }
+    }
+    auto actual = circuit_to_tableau<W>(circuit, false, false, false);
+    auto expected = circuit_to_tableau<W>(circuit, false, false, false, true).inverse();
+    ASSERT_EQ(actual, expected);
+
+    // Pauli product targets take the prepending path.
+    circuit = generate_test_circuit_with_all_operations();
+    actual = circuit_to_tableau<W>(circuit, true, true, true);
+    expected = circuit_to_tableau<W>(circuit, true, true, true, true).inverse();
+    ASSERT_EQ(actual, expected);
+})
+
 TEST_EACH_WORD_SIZE_W(conversions, tableau_to_circuit_fuzz_vs_circuit_to_tableau, {
     auto rng = INDEPENDENT_TEST_RNG();
     for (size_t n = 0; n < 10; n++) {
@@ -0,0 +1,93 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stim/util_top/reference_sample_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "stim/util_bot/probability_util.h"
+
+using namespace stim;
+
+static std::string hex_u64(uint64_t value) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)value);
+    return std::string(buf);
+}
+
+std::string stim::choose_reference_sample_cache_dir(const char *flag_value) {
+    if (flag_value != nullptr) {
+        return flag_value;
+    }
+    const char *env_value = std::getenv(REFERENCE_SAMPLE_CACHE_ENV_VAR);
+    if (env_value != nullptr) {
+        return env_value;
+    }
+    return "";
+}
+
+std::string stim::reference_sample_cache_file_name(const Circuit &circuit) {
+    // 64 bit FNV-1a hash of the noiseless circuit text.
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : circuit.aliased_noiseless_circuit().str()) {
+        hash ^= (uint8_t)c;
+        hash *= 1099511628211ULL;
+    }
+    return "ref_" + hex_u64(hash) + ".txt";
+}
+
+std::optional<ReferenceSampleTree> stim::read_cached_reference_sample(
+    const std::string &path, size_t expected_num_measurements) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return std::nullopt;
+    }
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        text.append(buf, n);
+    }
+    fclose(f);
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+        text.pop_back();
+    }
+
+    try {
+        ReferenceSampleTree tree = ReferenceSampleTree::from_str(text);
+        if (tree.size() != expected_num_measurements) {
+            // Hash collision, or a file that isn't a cache entry.
+            return std::nullopt;
+        }
+        return tree;
+    } catch (const std::invalid_argument &) {
+        return std::nullopt;
+    }
+}
+
+void stim::write_cached_reference_sample(const std::string &path, const ReferenceSampleTree &tree) {
+    std::string tmp_path = path + ".tmp_" + hex_u64(externally_seeded_rng()());
+    FILE *f = fopen(tmp_path.c_str(), "wb");
+    if (f == nullptr) {
+        return;
+    }
+    std::string text = tree.str();
+    text.push_back('\n');
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+    ok &= fclose(f) == 0;
+    if (!ok || rename(tmp_path.c_str(), path.c_str()) != 0) {
+        remove(tmp_path.c_str());
+    }
+}
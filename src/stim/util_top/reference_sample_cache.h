@@ -0,0 +1,82 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _STIM_UTIL_TOP_REFERENCE_SAMPLE_CACHE_H
+#define _STIM_UTIL_TOP_REFERENCE_SAMPLE_CACHE_H
+
+#include <optional>
+#include <string>
+
+#include "stim/circuit/circuit.h"
+#include "stim/util_top/reference_sample_tree.h"
+
+namespace stim {
+
+/// The environment variable used as the reference sample cache directory, when no directory is given explicitly.
+constexpr const char *REFERENCE_SAMPLE_CACHE_ENV_VAR = "STIM_REFERENCE_SAMPLE_CACHE";
+
+/// Determines which directory to use as the reference sample cache.
+///
+/// Args:
+///     flag_value: The directory given explicitly (e.g. via a command line flag), or nullptr if none was given.
+///
+/// Returns:
+///     The flag value if given, otherwise the value of the REFERENCE_SAMPLE_CACHE_ENV_VAR environment variable.
+///     Empty if neither is set, meaning reference samples shouldn't be cached.
+std::string choose_reference_sample_cache_dir(const char *flag_value);
+
+/// Returns the name of the file that caches the reference sample of the given circuit.
+///
+/// The name is derived from a hash of the circuit's text with noise removed, since noise doesn't affect the
+/// reference sample.
+std::string reference_sample_cache_file_name(const Circuit &circuit);
+
+/// Reads a cached reference sample tree.
+///
+/// Args:
+///     path: The cache file to read.
+///     expected_num_measurements: The number of measurements in the circuit the cache entry is for.
+///
+/// Returns:
+///     The cached tree, or std::nullopt if the file doesn't exist, can't be parsed, or has the wrong size.
+std::optional<ReferenceSampleTree> read_cached_reference_sample(
+    const std::string &path, size_t expected_num_measurements);
+
+/// Writes a reference sample tree into the cache.
+///
+/// The data is written to a temporary file that is then renamed into place, so that processes sharing the cache
+/// directory never see a partially written entry. Failures are ignored, since the cache is only an optimization.
+void write_cached_reference_sample(const std::string &path, const ReferenceSampleTree &tree);
+
+/// Computes a reference sample for the circuit, reusing a copy cached in the given directory when possible.
+///
+/// On a cache miss, the sample is computed with loop folding (see `reference_sample_circuit_with_loop_folding`) and
+/// its compressed tree is stored in the cache directory.
+///
+/// Args:
+///     circuit: The circuit to get a reference sample for.
+///     cache_dir: The directory holding cached reference samples. Must already exist.
+///
+/// Returns:
+///     The reference sample.
+template <size_t W>
+simd_bits<W> reference_sample_circuit_with_cache(const Circuit &circuit, const std::string &cache_dir);
+
+}  // namespace stim
+
+#include "stim/util_top/reference_sample_cache.inl"
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stim/util_top/reference_sample_cache.h"
+
+namespace stim {
+
+template <size_t W>
+simd_bits<W> reference_sample_circuit_with_cache(const Circuit &circuit, const std::string &cache_dir) {
+    size_t num_measurements = circuit.count_measurements();
+    std::string path = cache_dir + "/" + reference_sample_cache_file_name(circuit);
+
+    std::optional<ReferenceSampleTree> tree = read_cached_reference_sample(path, num_measurements);
+    if (!tree.has_value()) {
+        bool has_loops = false;
+        for (const auto &inst : circuit.operations) {
+            has_loops |= inst.gate_type == GateType::REPEAT;
+        }
+        if (has_loops) {
+            tree = ReferenceSampleTree::from_circuit_reference_sample(circuit.aliased_noiseless_circuit());
+        } else {
+            // Nothing to fold, so skip the overhead of tracking loop states.
+            simd_bits<W> sample = TableauSimulator<W>::reference_sample_circuit(circuit);
+            tree = ReferenceSampleTree{};
+            tree->repetitions = 1;
+            for (size_t k = 0; k < num_measurements; k++) {
+                tree->prefix_bits.push_back(sample[k]);
+            }
+        }
+        write_cached_reference_sample(path, *tree);
+    }
+
+    std::vector<bool> bits;
+    tree->decompress_into(bits);
+    simd_bits<W> result(bits.size());
+    for (size_t k = 0; k < bits.size(); k++) {
+        result[k] = bits[k];
+    }
+    return result;
+}
+
+}  // namespace stim
@@ -0,0 +1,120 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stim/util_top/reference_sample_cache.h"
+
+#include <cstdlib>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "stim/gen/gen_surface_code.h"
+#include "stim/util_bot/test_util.test.h"
+
+using namespace stim;
+
+struct RaiiTempDir {
+    std::string path;
+    RaiiTempDir() {
+        char name[] = "/tmp/stim_test_dir_XXXXXX";
+        if (mkdtemp(name) == nullptr) {
+            throw std::runtime_error("Failed to create temporary directory.");
+        }
+        path = name;
+    }
+    ~RaiiTempDir() {
+        rmdir(path.c_str());
+    }
+};
+
+TEST(reference_sample_cache, choose_reference_sample_cache_dir) {
+    unsetenv(REFERENCE_SAMPLE_CACHE_ENV_VAR);
+    ASSERT_EQ(choose_reference_sample_cache_dir(nullptr), "");
+    ASSERT_EQ(choose_reference_sample_cache_dir("abc"), "abc");
+
+    setenv(REFERENCE_SAMPLE_CACHE_ENV_VAR, "def", 1);
+    ASSERT_EQ(choose_reference_sample_cache_dir(nullptr), "def");
+    ASSERT_EQ(choose_reference_sample_cache_dir("abc"), "abc");
+    unsetenv(REFERENCE_SAMPLE_CACHE_ENV_VAR);
+}
+
+TEST(reference_sample_cache, file_name_ignores_noise) {
+    Circuit c1("H 0\nCX 0 1\nM 0 1");
+    Circuit c2("H 0\nDEPOLARIZE1(0.1) 0\nCX 0 1\nM(0.25) 0 1");
+    Circuit c3("H 0\nCX 0 1\nM 1 0");
+    ASSERT_EQ(reference_sample_cache_file_name(c1), reference_sample_cache_file_name(c2));
+    ASSERT_NE(reference_sample_cache_file_name(c1), reference_sample_cache_file_name(c3));
+}
+
+TEST(reference_sample_cache, read_write) {
+    RaiiTempNamedFile tmp;
+    ReferenceSampleTree tree{
+        .prefix_bits = {1, 0},
+        .suffix_children = {ReferenceSampleTree{.prefix_bits = {1}, .suffix_children = {}, .repetitions = 5}},
+        .repetitions = 2,
+    };
+    write_cached_reference_sample(tmp.path, tree);
+    ASSERT_EQ(tmp.read_contents(), "2*('10'+5*('1'))\n");
+    ASSERT_EQ(read_cached_reference_sample(tmp.path, 14), tree);
+
+    // Size mismatch.
+    ASSERT_EQ(read_cached_reference_sample(tmp.path, 13), std::nullopt);
+
+    // Unparseable.
+    tmp.write_contents("not a tree");
+    ASSERT_EQ(read_cached_reference_sample(tmp.path, 14), std::nullopt);
+
+    // Missing.
+    ASSERT_EQ(read_cached_reference_sample(tmp.path + "_does_not_exist", 14), std::nullopt);
+}
+
+TEST(reference_sample_cache, reference_sample_circuit_with_cache) {
+    RaiiTempDir dir;
+    CircuitGenParameters params(1000, 3, "rotated_memory_x");
+    params.after_clifford_depolarization = 0.125;
+    auto circuit = generate_surface_code_circuit(params).circuit;
+    circuit.blocks[0].append_from_text("X 10 11 12 13");
+    auto expected = TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(circuit);
+    std::string path = dir.path + "/" + reference_sample_cache_file_name(circuit);
+
+    // Miss.
+    ASSERT_EQ(read_cached_reference_sample(path, circuit.count_measurements()), std::nullopt);
+    ASSERT_EQ(reference_sample_circuit_with_cache<MAX_BITWORD_WIDTH>(circuit, dir.path), expected);
+    auto stored = read_cached_reference_sample(path, circuit.count_measurements());
+    ASSERT_TRUE(stored.has_value());
+    ASSERT_LT(stored->str().size(), 100);
+
+    // Hit.
+    ASSERT_EQ(reference_sample_circuit_with_cache<MAX_BITWORD_WIDTH>(circuit, dir.path), expected);
+
+    // A corrupted entry gets recomputed and replaced.
+    {
+        FILE *f = fopen(path.c_str(), "wb");
+        fputs("garbage", f);
+        fclose(f);
+    }
+    ASSERT_EQ(reference_sample_circuit_with_cache<MAX_BITWORD_WIDTH>(circuit, dir.path), expected);
+    ASSERT_EQ(read_cached_reference_sample(path, circuit.count_measurements()), stored);
+
+    // Circuits without loops are cached too.
+    Circuit no_loops("X 1\nH 2\nCX 2 3\nM 0 1 2 3");
+    std::string path2 = dir.path + "/" + reference_sample_cache_file_name(no_loops);
+    ASSERT_EQ(
+        reference_sample_circuit_with_cache<MAX_BITWORD_WIDTH>(no_loops, dir.path),
+        TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(no_loops));
+    ASSERT_EQ(read_cached_reference_sample(path2, 4)->str(), "1*('0100')");
+
+    remove(path.c_str());
+    remove(path2.c_str());
+}
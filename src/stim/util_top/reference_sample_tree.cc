@@ -172,6 +172,54 @@ ReferenceSampleTree ReferenceSampleTree::from_circuit_reference_sample(const Cir
     return helper.do_loop_with_tortoise_hare_folding(circuit, 1).simplified();
 }
 
+static ReferenceSampleTree parse_reference_sample_tree(std::string_view text, size_t &pos) {
+    auto expect = [&](char c) {
+        if (pos >= text.size() || text[pos] != c) {
+            throw std::invalid_argument(
+                "Expected '" + std::string(1, c) + "' at position " + std::to_string(pos) + " of reference sample tree.");
+        }
+        pos++;
+    };
+
+    ReferenceSampleTree result;
+    size_t digits_start = pos;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        if (result.repetitions > (SIZE_MAX - 9) / 10) {
+            throw std::invalid_argument("Reference sample tree repetition count is too large.");
+        }
+        result.repetitions = result.repetitions * 10 + (text[pos] - '0');
+        pos++;
+    }
+    if (pos == digits_start) {
+        throw std::invalid_argument(
+            "Expected a repetition count at position " + std::to_string(pos) + " of reference sample tree.");
+    }
+    expect('*');
+    expect('(');
+    expect('\'');
+    while (pos < text.size() && (text[pos] == '0' || text[pos] == '1')) {
+        result.prefix_bits.push_back(text[pos] == '1');
+        pos++;
+    }
+    expect('\'');
+    while (pos < text.size() && text[pos] == '+') {
+        pos++;
+        result.suffix_children.push_back(parse_reference_sample_tree(text, pos));
+    }
+    expect(')');
+    return result;
+}
+
+ReferenceSampleTree ReferenceSampleTree::from_str(std::string_view text) {
+    size_t pos = 0;
+    ReferenceSampleTree result = parse_reference_sample_tree(text, pos);
+    if (pos != text.size()) {
+        throw std::invalid_argument(
+            "Unexpected trailing text at position " + std::to_string(pos) + " of reference sample tree.");
+    }
+    return result;
+}
+
 std::string ReferenceSampleTree::str() const {
     std::stringstream ss;
     ss << *this;
@@ -16,6 +16,8 @@ struct ReferenceSampleTree {
 
     /// Initializes a reference sample tree containing a reference sample for the given circuit.
     static ReferenceSampleTree from_circuit_reference_sample(const Circuit &circuit);
+    /// Parses the description produced by `str`, like "5*('101'+6*('11'))".
+    static ReferenceSampleTree from_str(std::string_view text);
 
     /// Returns a tree with the same compressed contents, but a simpler tree structure.
     ReferenceSampleTree simplified() const;
@@ -73,6 +75,14 @@ struct CompressedReferenceSampleHelper {
 
 uint64_t max_feedback_lookback_in_loop(const Circuit &loop);
 
+/// Computes a reference sample for the given circuit, folding loops to avoid simulating every iteration.
+///
+/// Returns the same bits as `TableauSimulator<W>::reference_sample_circuit`. When the circuit contains REPEAT
+/// blocks, the sample is computed via `ReferenceSampleTree::from_circuit_reference_sample`, which stops simulating
+/// a loop once its state starts repeating. For QEC circuits this means only the first few rounds get simulated.
+template <size_t W>
+simd_bits<W> reference_sample_circuit_with_loop_folding(const Circuit &circuit);
+
 }  // namespace stim
 
 #include "stim/util_top/reference_sample_tree.inl"
@@ -140,4 +140,24 @@ bool CompressedReferenceSampleHelper<W>::in_same_recent_state_as(
     return sim.canonical_stabilizers() == other.sim.canonical_stabilizers();
 }
 
+template <size_t W>
+simd_bits<W> reference_sample_circuit_with_loop_folding(const Circuit &circuit) {
+    bool has_loops = false;
+    for (const auto &inst : circuit.operations) {
+        has_loops |= inst.gate_type == GateType::REPEAT;
+    }
+    if (!has_loops) {
+        // Nothing to fold.
+        return TableauSimulator<W>::reference_sample_circuit(circuit);
+    }
+
+    std::vector<bool> bits;
+    ReferenceSampleTree::from_circuit_reference_sample(circuit.aliased_noiseless_circuit()).decompress_into(bits);
+    simd_bits<W> result(bits.size());
+    for (size_t k = 0; k < bits.size(); k++) {
+        result[k] = bits[k];
+    }
+    return result;
+}
+
 }  // namespace stim
@@ -48,3 +48,17 @@ BENCHMARK(reference_sample_tree_nested_circuit) {
         std::cerr << "data dependence";
     }
 }
+
+BENCHMARK(reference_sample_circuit_with_loop_folding_surface_code_d7_r1000) {
+    CircuitGenParameters params(1000, 7, "rotated_memory_x");
+    params.after_clifford_depolarization = 0.001;
+    auto circuit = generate_surface_code_circuit(params).circuit;
+    size_t total = 0;
+    benchmark_go([&]() {
+        auto result = reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit);
+        total += result.not_zero();
+    }).goal_millis(10);
+    if (total) {
+        std::cerr << "data dependence";
+    }
+}
@@ -292,3 +292,74 @@ TEST(ReferenceSampleTree, surface_code_with_pauli_vs_normal_reference_sample) {
     ASSERT_EQ(ref.size(), circuit.count_measurements());
     expect_tree_matches_normal_reference_sample_of(ref, circuit);
 }
+
+TEST(reference_sample_circuit_with_loop_folding, matches_unfolded_reference_sample) {
+    CircuitGenParameters params(20, 3, "rotated_memory_x");
+    params.after_clifford_depolarization = 0.125;
+    params.before_measure_flip_probability = 0.125;
+    auto circuit = generate_surface_code_circuit(params).circuit;
+    circuit.blocks[0].append_from_text("X 10 11 12 13");
+    ASSERT_EQ(
+        reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit),
+        TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(circuit));
+
+    Circuit no_loops(R"CIRCUIT(
+        X_ERROR(1) 0
+        X 1
+        H 2
+        CX 2 3
+        M 0 1 2 3
+    )CIRCUIT");
+    ASSERT_EQ(
+        reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(no_loops),
+        TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(no_loops));
+
+    Circuit feedback(R"CIRCUIT(
+        X 0
+        M 0
+        REPEAT 100 {
+            CX rec[-1] 1
+            M 1
+            H 0
+            M 0
+        }
+    )CIRCUIT");
+    ASSERT_EQ(
+        reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(feedback),
+        TableauSimulator<MAX_BITWORD_WIDTH>::reference_sample_circuit(feedback));
+}
+
+TEST(reference_sample_circuit_with_loop_folding, skips_most_iterations) {
+    CircuitGenParameters params(1000000, 3, "rotated_memory_x");
+    params.after_clifford_depolarization = 0.001;
+    auto circuit = generate_surface_code_circuit(params).circuit;
+    auto ref = reference_sample_circuit_with_loop_folding<MAX_BITWORD_WIDTH>(circuit);
+    ASSERT_GE(ref.num_bits_padded(), circuit.count_measurements());
+    ASSERT_FALSE(ref.not_zero());
+}
+
+TEST(ReferenceSampleTree, from_str) {
+    for (const auto &text : std::vector<std::string>{
+             "0*('')",
+             "2*('1101')",
+             "2*('1101'+5*('1'))",
+             "1*(''+10000*('000000000000000000000000')+1*('0000000000000000000000000'))",
+             "1*('1'+2*('01'+3*(''))+4*('0'))",
+         }) {
+        ASSERT_EQ(ReferenceSampleTree::from_str(text).str(), text);
+    }
+
+    CircuitGenParameters params(10000, 3, "rotated_memory_x");
+    auto circuit = generate_surface_code_circuit(params).circuit;
+    circuit.blocks[0].append_from_text("X 10 11 12 13");
+    auto tree = ReferenceSampleTree::from_circuit_reference_sample(circuit);
+    ASSERT_EQ(ReferenceSampleTree::from_str(tree.str()), tree);
+
+    ASSERT_THROW({ ReferenceSampleTree::from_str(""); }, std::invalid_argument);
+    ASSERT_THROW({ ReferenceSampleTree::from_str("*('')"); }, std::invalid_argument);
+    ASSERT_THROW({ ReferenceSampleTree::from_str("1*('2')"); }, std::invalid_argument);
+    ASSERT_THROW({ ReferenceSampleTree::from_str("1*('1'"); }, std::invalid_argument);
+    ASSERT_THROW({ ReferenceSampleTree::from_str("1*('1')+"); }, std::invalid_argument);
+    ASSERT_THROW({ ReferenceSampleTree::from_str("1*('1'+)"); }, std::invalid_argument);
+    ASSERT_THROW({ ReferenceSampleTree::from_str("99999999999999999999999*('1')"); }, std::invalid_argument);
+}